@@ -1,7 +1,11 @@
 import importlib
 from . import config
 import atexit
+import struct
 import os
+import concurrent.futures
+import queue
+import threading
 
 HEAP_DEFAULT = 0
 HEAP_UPLOAD = 1
@@ -20,6 +24,10 @@ SAMPLER_ADDRESS_MODE_WRAP = 0
 SAMPLER_ADDRESS_MODE_MIRROR = 1
 SAMPLER_ADDRESS_MODE_CLAMP = 2
 
+USAGE_READ_ONLY = 1
+USAGE_STORAGE = 2
+USAGE_TRANSFER = 4
+
 
 class UnknownBackend(Exception):
     pass
@@ -52,6 +60,7 @@ class HeapException(Exception):
 _backend = None
 _discovered_devices = None
 _current_device = None
+_compute_executor = None
 
 
 def get_backend():
@@ -117,6 +126,8 @@ class Resource:
         dst_z=0,
         src_slice=0,
         dst_slice=0,
+        buffer_row_pitch=0,
+        buffer_slice_pitch=0,
     ):
         self.handle.copy_to(
             destination.handle,
@@ -134,6 +145,8 @@ class Resource:
             dst_z,
             src_slice,
             dst_slice,
+            buffer_row_pitch,
+            buffer_slice_pitch,
         )
 
     @property
@@ -157,6 +170,24 @@ class Resource:
             x, y, z, heap.handle if heap else None, heap_offset, slice
         )
 
+    def bind_tiles(self, tiles):
+        tiles = [
+            (
+                tile[0],
+                tile[1],
+                tile[2],
+                tile[3].handle if tile[3] else None,
+                tile[4] if len(tile) > 4 else 0,
+                tile[5] if len(tile) > 5 else 0,
+            )
+            for tile in tiles
+        ]
+        if hasattr(self.handle, "bind_tiles"):
+            self.handle.bind_tiles(tiles)
+        else:
+            for tile in tiles:
+                self.handle.bind_tile(*tile)
+
     @property
     def tiles_x(self):
         return self.handle.tiles_x
@@ -181,6 +212,38 @@ class Resource:
     def tile_depth(self):
         return self.handle.tile_depth
 
+    @property
+    def mips(self):
+        return getattr(self.handle, "mips", 1)
+
+    @property
+    def usage(self):
+        return getattr(
+            self.handle, "usage", USAGE_READ_ONLY | USAGE_STORAGE | USAGE_TRANSFER
+        )
+
+    @property
+    def mip_level(self):
+        return getattr(self.handle, "mip_level", 0)
+
+    def mip(self, level):
+        return self._view(self.handle.mip(level))
+
+    def generate_mips(self):
+        self.handle.generate_mips()
+
+    @property
+    def bindless_index(self):
+        return self.handle.get_bindless_index()
+
+    def _view(self, handle):
+        view = self.__class__.__new__(self.__class__)
+        view.device = self.device
+        view.heap = self.heap
+        view.parent = self
+        view.handle = handle
+        return view
+
 
 class Buffer(Resource):
     def __init__(
@@ -192,6 +255,7 @@ class Buffer(Resource):
         heap=None,
         heap_offset=0,
         sparse=False,
+        usage=0,
         device=None,
     ):
         self.device = device if device else get_current_device()
@@ -204,11 +268,28 @@ class Buffer(Resource):
             heap.handle if heap else None,
             heap_offset,
             sparse,
+            *([usage] if usage else []),
         )
+        self._alias_handle_methods()
+
+    def _alias_handle_methods(self):
+        # the Vulkan handles accept the same arguments of the wrappers (a writable
+        # buffer included for readback), so they are called directly saving a python frame
+        if get_backend().name == "vulkan":
+            self.upload = self.handle.upload
+            self.readback = self.handle.readback
+
+    def _view(self, handle):
+        view = super()._view(handle)
+        view._alias_handle_methods()
+        return view
 
     def upload(self, data, offset=0):
         self.handle.upload(data, offset)
 
+    def view(self, offset, size=0, stride=0, format=0):
+        return self._view(self.handle.view(offset, size, stride, format))
+
     def upload2d(self, data, pitch, width, height, bytes_per_pixel):
         return self.handle.upload2d(data, pitch, width, height, bytes_per_pixel)
 
@@ -223,6 +304,40 @@ class Buffer(Resource):
     def readback2d(self, pitch, width, height, bytes_per_pixel):
         return self.handle.readback2d(pitch, width, height, bytes_per_pixel)
 
+    def _open_file(self, path_or_fd, flags):
+        if isinstance(path_or_fd, int):
+            return path_or_fd, False
+        if hasattr(path_or_fd, "fileno"):
+            return path_or_fd.fileno(), False
+        return os.open(path_or_fd, flags | getattr(os, "O_BINARY", 0), 0o644), True
+
+    def upload_file(self, path_or_fd, file_offset=0, size=0, dst_offset=0):
+        fd, owned = self._open_file(path_or_fd, os.O_RDONLY)
+        try:
+            if size == 0:
+                size = min(
+                    os.fstat(fd).st_size - file_offset, self.handle.size - dst_offset
+                )
+            self.handle.upload_file(fd, file_offset, size, dst_offset)
+        finally:
+            if owned:
+                os.close(fd)
+
+    def readback_to_file(self, path_or_fd, file_offset=0, size=0, src_offset=0):
+        fd, owned = self._open_file(path_or_fd, os.O_WRONLY | os.O_CREAT)
+        try:
+            if size == 0:
+                size = self.handle.size - src_offset
+            self.handle.readback_to_file(fd, file_offset, size, src_offset)
+        finally:
+            if owned:
+                os.close(fd)
+
+    @property
+    def device_address(self):
+        device_address = getattr(self.handle, "device_address", 0)
+        return device_address if device_address else None
+
 
 class Texture1D(Resource):
     def __init__(
@@ -233,14 +348,26 @@ class Texture1D(Resource):
         heap_offset=0,
         slices=1,
         sparse=False,
+        mips=1,
+        usage=0,
         device=None,
     ):
         self.device = device if device else get_current_device()
         self.heap = heap
         self.handle = self.device.create_texture1d(
-            width, format, heap.handle if heap else None, heap_offset, slices, sparse
+            width,
+            format,
+            heap.handle if heap else None,
+            heap_offset,
+            slices,
+            sparse,
+            mips,
+            *([usage] if usage else []),
         )
 
+    def view(self, first_slice, num_slices=0):
+        return self._view(self.handle.view(first_slice, num_slices))
+
     @property
     def width(self):
         return self.handle.width
@@ -264,6 +391,8 @@ class Texture2D(Resource):
         heap_offset=0,
         slices=1,
         sparse=False,
+        mips=1,
+        usage=0,
         device=None,
     ):
         self.device = device if device else get_current_device()
@@ -276,8 +405,13 @@ class Texture2D(Resource):
             heap_offset,
             slices,
             sparse,
+            mips,
+            *([usage] if usage else []),
         )
 
+    def view(self, first_slice, num_slices=0):
+        return self._view(self.handle.view(first_slice, num_slices))
+
     @property
     def width(self):
         return self.handle.width
@@ -305,6 +439,8 @@ class Texture3D(Resource):
         heap=None,
         heap_offset=0,
         sparse=False,
+        mips=1,
+        usage=0,
         device=None,
     ):
         self.device = device if device else get_current_device()
@@ -317,8 +453,13 @@ class Texture3D(Resource):
             heap.handle if heap else None,
             heap_offset,
             sparse,
+            mips,
+            *([usage] if usage else []),
         )
 
+    def view(self, first_z, depth=0):
+        return self._view(self.handle.view(first_z, depth))
+
     @property
     def width(self):
         return self.handle.width
@@ -398,9 +539,23 @@ class Compute:
         push_size=0,
         bindless=False,
         max_bindless=64,
+        subgroup_size=0,
+        push_descriptors=False,
+        constants_size=0,
         device=None,
     ):
         self.device = device if device else get_current_device()
+        kwargs = {}
+        if subgroup_size:
+            kwargs["subgroup_size"] = subgroup_size
+        if push_descriptors:
+            if get_backend().name != "vulkan":
+                raise ValueError(
+                    "push descriptors are supported only by the Vulkan backend"
+                )
+            kwargs["push_descriptors"] = True
+        if constants_size:
+            kwargs["constants_size"] = constants_size
         self.handle = self.device.create_compute(
             shader,
             cbv=[resource.handle for resource in cbv],
@@ -409,16 +564,221 @@ class Compute:
             samplers=[sampler.handle for sampler in samplers],
             push_size=push_size,
             bindless=max_bindless if bindless else 0,
+            **kwargs
+        )
+
+    @classmethod
+    def create_async(cls, shader, *args, device=None, **kwargs):
+        # the backends release the GIL while building the pipeline, so multiple
+        # Compute objects can be compiled in parallel
+        global _compute_executor
+        if _compute_executor is None:
+            _compute_executor = concurrent.futures.ThreadPoolExecutor(
+                thread_name_prefix="compushady-compute"
+            )
+        return _compute_executor.submit(
+            cls,
+            shader,
+            *args,
+            device=device if device else get_current_device(),
+            **kwargs
+        )
+
+    def dispatch(
+        self,
+        x,
+        y,
+        z,
+        push=None,
+        cbv=None,
+        srv=None,
+        uav=None,
+        constants=None,
+        wait=True,
+    ):
+        if wait and cbv is None and srv is None and uav is None and constants is None:
+            self.handle.dispatch(x, y, z, push if push else b"")
+            return
+
+        # the other backends' handles do not accept the additional arguments
+        if not (cbv is None and srv is None and uav is None) and not getattr(
+            self.handle, "push_descriptors", False
+        ):
+            raise ValueError(
+                "resources can be passed to dispatch() only by Compute objects created with push_descriptors=True (Vulkan only)"
+            )
+        if get_backend().name != "vulkan":
+            raise ValueError(
+                "constants and wait=False are supported only by the Vulkan backend"
+            )
+
+        def _handles(resources):
+            if resources is None:
+                return None
+            return [resource.handle if resource else None for resource in resources]
+
+        args = [_handles(cbv), _handles(srv), _handles(uav)]
+        if constants is not None:
+            args.append(constants)
+        self.handle.dispatch(
+            x, y, z, push if push else b"", *args, **({} if wait else {"wait": False})
+        )
+
+    @property
+    def thread_group_size(self):
+        if not hasattr(self.handle, "thread_group_size_x"):
+            return None
+        return (
+            self.handle.thread_group_size_x,
+            self.handle.thread_group_size_y,
+            self.handle.thread_group_size_z,
         )
 
-    def dispatch(self, x, y, z, push=None):
-        self.handle.dispatch(x, y, z, push if push else b"")
+    @property
+    def bindings(self):
+        return getattr(self.handle, "bindings", None)
+
+    def dispatch_threads(self, x, y=1, z=1, push=None):
+        thread_group_size = self.thread_group_size
+        if thread_group_size is None:
+            raise ValueError("thread group size is not available on this backend")
+        self.dispatch(
+            (x + thread_group_size[0] - 1) // thread_group_size[0],
+            (y + thread_group_size[1] - 1) // thread_group_size[1],
+            (z + thread_group_size[2] - 1) // thread_group_size[2],
+            push,
+        )
+
+    def dispatch_many(self, groups, push=None):
+        if hasattr(groups, "astype"):
+            groups = groups.astype("uint32", order="C", copy=False)
+        elif isinstance(groups, (list, tuple)):
+            groups = struct.pack(
+                "<{0}I".format(len(groups) * 3),
+                *[value for group in groups for value in group]
+            )
+        if push is None:
+            push = b""
+        elif isinstance(push, (list, tuple)):
+            push = b"".join(push)
+        if not hasattr(self.handle, "dispatch_many"):
+            groups = memoryview(groups).cast("B").cast("I")
+            dispatches = len(groups) // 3
+            push = memoryview(push).cast("B")
+            push_stride = len(push) // dispatches if dispatches > 0 else 0
+            for i in range(0, dispatches):
+                self.handle.dispatch(
+                    groups[i * 3],
+                    groups[i * 3 + 1],
+                    groups[i * 3 + 2],
+                    push[i * push_stride : (i + 1) * push_stride].tobytes(),
+                )
+            return
+        self.handle.dispatch_many(groups, push)
 
     def dispatch_indirect(self, indirect_buffer, offset=0, push=None):
         self.handle.dispatch_indirect(
             indirect_buffer.handle, offset, push if push else b""
         )
 
+    def dispatch_indirect_many(
+        self, indirect_buffer, offset=0, count=1, stride=12, push=None
+    ):
+        if not hasattr(self.handle, "dispatch_indirect_many"):
+            for i in range(0, count):
+                self.handle.dispatch_indirect(
+                    indirect_buffer.handle, offset + i * stride, push if push else b""
+                )
+            return
+        self.handle.dispatch_indirect_many(
+            indirect_buffer.handle, offset, count, stride, push if push else b""
+        )
+
+    def dispatch_indirect_count(
+        self,
+        indirect_buffer,
+        count_buffer,
+        max_count,
+        offset=0,
+        count_offset=0,
+        stride=12,
+        push=None,
+    ):
+        if max_count == 0:
+            return
+        if stride < 12 or stride % 4 != 0:
+            raise ValueError(
+                "Invalid indirect stride ({0}), must be at least 12 bytes and 4 bytes aligned".format(
+                    stride
+                )
+            )
+        prologue = self._get_indirect_count_prologue(max_count, stride)
+        copies = [
+            _copy_command(
+                indirect_buffer,
+                prologue["args"],
+                (max_count - 1) * stride + 12,
+                src_offset=offset,
+            ),
+            _copy_command(count_buffer, prologue["count"], 4, src_offset=count_offset),
+        ]
+        prologue_dispatch = (
+            prologue["compute"].handle.dispatch,
+            ((max_count + 63) // 64, 1, 1, struct.pack("<II", stride // 4, max_count)),
+        )
+        # the copies, the prologue and the dispatches are a single submission
+        if hasattr(self.handle, "dispatch_indirect_many"):
+            _submit_batch(
+                self.device,
+                copies
+                + [
+                    prologue_dispatch,
+                    (
+                        self.handle.dispatch_indirect_many,
+                        (
+                            prologue["commands"].handle,
+                            0,
+                            max_count,
+                            12,
+                            push if push else b"",
+                        ),
+                    ),
+                ],
+            )
+            return
+        _submit_batch(self.device, copies + [prologue_dispatch])
+        self.dispatch_indirect_many(prologue["commands"], 0, max_count, 12, push)
+
+    def _get_indirect_count_prologue(self, max_count, stride):
+        prologue = getattr(self, "_indirect_count_prologue", None)
+        if (
+            prologue is None
+            or prologue["max_count"] < max_count
+            or prologue["stride"] != stride
+        ):
+            from . import kernels
+            from .formats import R32_UINT
+
+            args = Buffer(max_count * stride, format=R32_UINT, device=self.device)
+            count = Buffer(4, format=R32_UINT, device=self.device)
+            commands = Buffer(max_count * 12, format=R32_UINT, device=self.device)
+            prologue = {
+                "max_count": max_count,
+                "stride": stride,
+                "args": args,
+                "count": count,
+                "commands": commands,
+                "compute": Compute(
+                    kernels.get("indirect_count_prologue"),
+                    srv=[args, count],
+                    uav=[commands],
+                    push_size=8,
+                    device=self.device,
+                ),
+            }
+            self._indirect_count_prologue = prologue
+        return prologue
+
     def bind_cbv(self, index, cbv):
         self.handle.bind_cbv(index, cbv.handle)
 
@@ -427,3 +787,201 @@ class Compute:
 
     def bind_uav(self, index, uav):
         self.handle.bind_uav(index, uav.handle)
+
+    def _bind_many(self, method, start_index, resources):
+        handles = [resource.handle for resource in resources]
+        if hasattr(self.handle, method + "_many"):
+            getattr(self.handle, method + "_many")(start_index, handles)
+        else:
+            for index, handle in enumerate(handles):
+                getattr(self.handle, method)(start_index + index, handle)
+
+    def bind_cbv_many(self, start_index, cbvs):
+        self._bind_many("bind_cbv", start_index, cbvs)
+
+    def bind_srv_many(self, start_index, srvs):
+        self._bind_many("bind_srv", start_index, srvs)
+
+    def bind_uav_many(self, start_index, uavs):
+        self._bind_many("bind_uav", start_index, uavs)
+
+
+def _submit_batch(device, commands, wait=True):
+    # on Vulkan the (handle method, arguments) commands are recorded in a single
+    # submission whose serial is returned, the other backends run (and wait
+    # for) them one by one
+    if hasattr(device, "submit_batch"):
+        return device.submit_batch(commands, wait)
+    for method, args in commands:
+        method(*args)
+    return None
+
+
+def _copy_command(source, destination, size, src_offset=0, dst_offset=0):
+    # the d3d12 and metal handles require all of the positional arguments
+    return (
+        source.handle.copy_to,
+        (destination.handle, size, src_offset, dst_offset) + (0,) * 13,
+    )
+
+
+class StreamProcessor:
+    """Processes a sequence of chunks keeping up to num_slots of them in flight.
+
+    Every slot has its own staging buffers, device buffers and Compute: the copy of a chunk to the GPU,
+    its dispatch and the copy of the results are recorded in a single submission that is not waited for,
+    and the slot is retired by waiting for the fence of that submission before reading back.
+    """
+
+    def __init__(
+        self,
+        shader,
+        input_size,
+        output_size,
+        groups,
+        push=None,
+        readback_size=None,
+        input_format=0,
+        output_format=0,
+        push_size=0,
+        num_slots=3,
+        device=None,
+    ):
+        if num_slots < 2:
+            raise ValueError("StreamProcessor requires at least 2 slots")
+        self.device = device if device else get_current_device()
+        self.input_size = input_size
+        self.output_size = output_size
+        self.groups = groups
+        self.push = push
+        self.readback_size = readback_size
+        self.slots = []
+        for i in range(0, num_slots):
+            input_buffer = Buffer(input_size, format=input_format, device=self.device)
+            output_buffer = Buffer(
+                output_size, format=output_format, device=self.device
+            )
+            self.slots.append(
+                {
+                    "upload": Buffer(input_size, HEAP_UPLOAD, device=self.device),
+                    "input": input_buffer,
+                    "output": output_buffer,
+                    "readback": Buffer(output_size, HEAP_READBACK, device=self.device),
+                    "compute": Compute(
+                        shader,
+                        srv=[input_buffer],
+                        uav=[output_buffer],
+                        push_size=push_size,
+                        device=self.device,
+                    ),
+                    "serial": None,
+                    "readback_size": 0,
+                }
+            )
+
+    def _get(self, value, size):
+        return value(size) if callable(value) else value
+
+    def _submit(self, slot, size):
+        readback_size = self._get(self.readback_size, size)
+        if readback_size is None:
+            readback_size = size
+        if readback_size > self.output_size:
+            raise ValueError(
+                "readback of {0} bytes does not fit in the output buffer ({1} bytes)".format(
+                    readback_size, self.output_size
+                )
+            )
+        x, y, z = self._get(self.groups, size)
+        push = self._get(self.push, size)
+        slot["readback_size"] = readback_size
+        slot["serial"] = _submit_batch(
+            self.device,
+            [
+                _copy_command(slot["upload"], slot["input"], size),
+                (slot["compute"].handle.dispatch, (x, y, z, push if push else b"")),
+                _copy_command(slot["output"], slot["readback"], readback_size),
+            ],
+            False,
+        )
+
+    def _retire(self, slot):
+        if slot["serial"] is not None:
+            self.device.wait_for(slot["serial"])
+            slot["serial"] = None
+
+    def _feed(self, chunks, free_slots, done_queue, state):
+        try:
+            for chunk in chunks:
+                chunk = memoryview(chunk).cast("B")
+                if chunk.nbytes == 0:
+                    continue
+                if chunk.nbytes > self.input_size:
+                    raise ValueError(
+                        "chunk of {0} bytes does not fit in the input buffer ({1} bytes)".format(
+                            chunk.nbytes, self.input_size
+                        )
+                    )
+                slot = free_slots.get()
+                if state["abort"]:
+                    break
+                slot["upload"].upload(chunk)
+                self._submit(slot, chunk.nbytes)
+                done_queue.put(slot)
+        except BaseException as e:
+            state["error"] = e
+            state["abort"] = True
+        finally:
+            done_queue.put(None)
+
+    def run(self, chunks, sink):
+        if hasattr(sink, "write"):
+            sink = sink.write
+        free_slots = queue.Queue()
+        done_queue = queue.Queue()
+        for slot in self.slots:
+            free_slots.put(slot)
+        state = {"abort": False, "error": None}
+
+        # the feeder uploads and submits the chunks while this thread retires
+        # the slots in order and passes their results to the sink
+        feeder = threading.Thread(
+            target=self._feed,
+            args=(iter(chunks), free_slots, done_queue, state),
+            name="compushady-stream-feeder",
+        )
+        feeder.start()
+
+        try:
+            while True:
+                slot = done_queue.get()
+                if slot is None:
+                    break
+                data = None
+                if not state["abort"]:
+                    try:
+                        self._retire(slot)
+                        data = slot["readback"].readback(slot["readback_size"])
+                    except BaseException as e:
+                        state["error"] = e
+                        state["abort"] = True
+                free_slots.put(slot)
+                if not state["abort"]:
+                    try:
+                        sink(data)
+                    except BaseException as e:
+                        state["error"] = e
+                        state["abort"] = True
+        finally:
+            # a blocked feeder needs a slot to notice the abort (when the
+            # chunks are over it has already returned)
+            state["abort"] = True
+            for slot in self.slots:
+                free_slots.put(slot)
+            feeder.join()
+            # the slots still in flight after an abort are waited for before being reused
+            for slot in self.slots:
+                self._retire(slot)
+
+        if state["error"] is not None:
+            raise state["error"]
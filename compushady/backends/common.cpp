@@ -1,4 +1,13 @@
 #include "compushady.h"
+#include <thread>
+#include <system_error>
+#include <errno.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 PyObject *Compushady_BufferError = NULL;
 PyObject *Compushady_Texture1DError = NULL;
@@ -219,7 +228,23 @@ size_t compushady_get_size_by_pitch(const size_t pitch, const size_t width, cons
 	return pitch;
 }
 
-bool compushady_check_copy_to(const bool src_is_buffer, const bool dst_is_buffer, const uint64_t size, const uint64_t src_offset, const uint64_t dst_offset, const uint64_t src_size, const uint64_t dst_size, const uint32_t src_x, const uint32_t src_y, const uint32_t src_z, const uint32_t src_slice, const uint32_t src_slices, const uint32_t dst_slice, const uint32_t dst_slices, const uint32_t src_width, const uint32_t src_height, const uint32_t src_depth, const uint32_t dst_width, const uint32_t dst_height, const uint32_t dst_depth, uint32_t *dst_x, uint32_t *dst_y, uint32_t *dst_z, uint32_t *width, uint32_t *height, uint32_t *depth)
+uint32_t compushady_get_max_mips(const uint32_t width, const uint32_t height, const uint32_t depth)
+{
+	uint32_t max_size = width > height ? width : height;
+	if (depth > max_size)
+	{
+		max_size = depth;
+	}
+	uint32_t mips = 1;
+	while (max_size > 1)
+	{
+		max_size >>= 1;
+		mips++;
+	}
+	return mips;
+}
+
+bool compushady_check_copy_to(const bool src_is_buffer, const bool dst_is_buffer, const uint64_t size, const uint64_t src_offset, const uint64_t dst_offset, const uint64_t src_size, const uint64_t dst_size, const uint32_t src_x, const uint32_t src_y, const uint32_t src_z, const uint32_t src_slice, const uint32_t src_slices, const uint32_t dst_slice, const uint32_t dst_slices, const uint32_t src_width, const uint32_t src_height, const uint32_t src_depth, const uint32_t dst_width, const uint32_t dst_height, const uint32_t dst_depth, uint32_t *dst_x, uint32_t *dst_y, uint32_t *dst_z, uint32_t *width, uint32_t *height, uint32_t *depth, const uint32_t bytes_per_pixel, const uint32_t row_pitch_alignment, uint64_t *buffer_row_pitch, uint64_t *buffer_slice_pitch)
 {
 	// buffer to buffer
 	if (src_is_buffer && dst_is_buffer)
@@ -233,33 +258,84 @@ bool compushady_check_copy_to(const bool src_is_buffer, const bool dst_is_buffer
 			return false;
 		}
 	}
-	// buffer to texture
-	else if (src_is_buffer && !dst_is_buffer)
+	// buffer to texture / texture to buffer
+	else if (src_is_buffer != dst_is_buffer)
 	{
-		*dst_x = 0;
-		*dst_y = 0;
-		*dst_z = 0;
-		if (src_offset + size > src_size || size < dst_size || dst_slice >= dst_slices)
+		// the texture box is always expressed by the texture side of the copy
+		const uint32_t texture_x = src_is_buffer ? *dst_x : src_x;
+		const uint32_t texture_y = src_is_buffer ? *dst_y : src_y;
+		const uint32_t texture_z = src_is_buffer ? *dst_z : src_z;
+		const uint32_t texture_width = src_is_buffer ? dst_width : src_width;
+		const uint32_t texture_height = src_is_buffer ? dst_height : src_height;
+		const uint32_t texture_depth = src_is_buffer ? dst_depth : src_depth;
+		const uint32_t texture_slice = src_is_buffer ? dst_slice : src_slice;
+		const uint32_t texture_slices = src_is_buffer ? dst_slices : src_slices;
+		const uint64_t buffer_size = src_is_buffer ? src_size : dst_size;
+		const uint64_t buffer_offset = src_is_buffer ? src_offset : dst_offset;
+
+		if (texture_x >= texture_width || texture_y >= texture_height || texture_z >= texture_depth || texture_slice >= texture_slices)
 		{
 			PyErr_Format(PyExc_ValueError,
-						 "Resource requested size to copy (%llu) is out of bounds "
-						 "(src_size: %llu, src_offset: %llu, dst_size: %llu, dst_width: %u, dst_height: %u, dst_depth: %u dst_slices: %u)",
-						 size, size, src_offset, dst_size, dst_width, dst_height, dst_depth, dst_slices);
+						 "Resource requested texture offset (x: %u, y: %u, z: %u, slice: %u) is out of bounds "
+						 "(width: %u, height: %u, depth: %u, slices: %u)",
+						 texture_x, texture_y, texture_z, texture_slice, texture_width, texture_height, texture_depth, texture_slices);
 			return false;
 		}
-	}
-	// texture to buffer
-	else if (!src_is_buffer && dst_is_buffer)
-	{
-		*dst_x = 0;
-		*dst_y = 0;
-		*dst_z = 0;
-		if (dst_offset + size > dst_size || size < src_size || src_slice > src_slices)
+
+		if (*width == 0)
+		{
+			*width = texture_width - texture_x;
+		}
+
+		if (*height == 0)
+		{
+			*height = texture_height - texture_y;
+		}
+
+		if (*depth == 0)
+		{
+			*depth = texture_depth - texture_z;
+		}
+
+		if (texture_x + *width > texture_width || texture_y + *height > texture_height || texture_z + *depth > texture_depth)
+		{
+			PyErr_Format(PyExc_ValueError,
+						 "Resource requested size to copy (width: %u, height: %u, depth: %u) is out of bounds "
+						 "(x: %u, y: %u, z: %u, width: %u, height: %u, depth: %u)",
+						 *width, *height, *depth, texture_x, texture_y, texture_z, texture_width, texture_height, texture_depth);
+			return false;
+		}
+
+		const uint64_t packed_row_pitch = (uint64_t)*width * bytes_per_pixel;
+
+		if (*buffer_row_pitch == 0)
+		{
+			*buffer_row_pitch = ((packed_row_pitch + row_pitch_alignment - 1) / row_pitch_alignment) * row_pitch_alignment;
+		}
+
+		if (*buffer_slice_pitch == 0)
+		{
+			*buffer_slice_pitch = *buffer_row_pitch * *height;
+		}
+
+		if (*buffer_row_pitch < packed_row_pitch || *buffer_row_pitch % row_pitch_alignment || *buffer_slice_pitch < *buffer_row_pitch * *height || *buffer_slice_pitch % *buffer_row_pitch)
+		{
+			PyErr_Format(PyExc_ValueError,
+						 "Invalid buffer pitch (row_pitch: %llu, slice_pitch: %llu) for copying (width: %u, height: %u) "
+						 "(row_pitch must be a multiple of %u and slice_pitch a multiple of row_pitch)",
+						 *buffer_row_pitch, *buffer_slice_pitch, *width, *height, row_pitch_alignment);
+			return false;
+		}
+
+		const uint64_t required_size = *buffer_slice_pitch * (*depth - 1) + *buffer_row_pitch * (*height - 1) + packed_row_pitch;
+
+		// a zero size means "whatever the box requires"
+		if ((size > 0 && size < required_size) || buffer_offset + required_size > buffer_size)
 		{
 			PyErr_Format(PyExc_ValueError,
 						 "Resource requested size to copy (%llu) is out of bounds "
-						 "(dst_size: %llu, dst_offset: %llu, src_size: %llu, src_width: %u, src_height: %u, src_depth: %u src_slices: %u)",
-						 size, dst_size, src_offset, dst_size, src_width, src_height, src_depth, src_slices);
+						 "(buffer_size: %llu, buffer_offset: %llu, required_size: %llu, width: %u, height: %u, depth: %u)",
+						 size, buffer_size, buffer_offset, required_size, *width, *height, *depth);
 			return false;
 		}
 	}
@@ -292,4 +368,250 @@ bool compushady_check_copy_to(const bool src_is_buffer, const bool dst_is_buffer
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+static bool compushady_fastcall_set_slot(const char *name, const char *const *kwlist, const Py_ssize_t num_slots, PyObject **slots, PyObject *py_key, PyObject *py_value)
+{
+	for (Py_ssize_t i = 0; i < num_slots; i++)
+	{
+		if (!PyUnicode_CompareWithASCIIString(py_key, kwlist[i]))
+		{
+			if (slots[i])
+			{
+				PyErr_Format(PyExc_TypeError, "argument for %s() given by name ('%s') and position (%zd)", name, kwlist[i], i + 1);
+				return false;
+			}
+			slots[i] = py_value;
+			return true;
+		}
+	}
+
+	PyErr_Format(PyExc_TypeError, "'%U' is an invalid keyword argument for %s()", py_key, name);
+	return false;
+}
+
+bool compushady_fastcall_parse(const char *name, const char *const *kwlist, const Py_ssize_t required, PyObject **slots, COMPUSHADY_FASTCALL_ARGS)
+{
+	Py_ssize_t num_slots = 0;
+	while (kwlist[num_slots])
+	{
+		slots[num_slots++] = NULL;
+	}
+
+#if PY_VERSION_HEX >= 0x03070000
+	const Py_ssize_t num_args = nargs;
+#else
+	const Py_ssize_t num_args = PyTuple_GET_SIZE(args);
+#endif
+
+	if (num_args > num_slots)
+	{
+		PyErr_Format(PyExc_TypeError, "%s() takes at most %zd arguments (%zd given)", name, num_slots, num_args);
+		return false;
+	}
+
+	for (Py_ssize_t i = 0; i < num_args; i++)
+	{
+#if PY_VERSION_HEX >= 0x03070000
+		slots[i] = args[i];
+#else
+		slots[i] = PyTuple_GET_ITEM(args, i);
+#endif
+	}
+
+#if PY_VERSION_HEX >= 0x03070000
+	if (kwnames)
+	{
+		for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(kwnames); i++)
+		{
+			if (!compushady_fastcall_set_slot(name, kwlist, num_slots, slots, PyTuple_GET_ITEM(kwnames, i), args[num_args + i]))
+			{
+				return false;
+			}
+		}
+	}
+#else
+	if (kwds)
+	{
+		PyObject *py_key;
+		PyObject *py_value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(kwds, &pos, &py_key, &py_value))
+		{
+			if (!compushady_fastcall_set_slot(name, kwlist, num_slots, slots, py_key, py_value))
+			{
+				return false;
+			}
+		}
+	}
+#endif
+
+	for (Py_ssize_t i = 0; i < required; i++)
+	{
+		if (!slots[i])
+		{
+			PyErr_Format(PyExc_TypeError, "%s() missing required argument '%s' (pos %zd)", name, kwlist[i], i + 1);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// like the 'I' format of PyArg_ParseTuple (a missing argument keeps the default value)
+bool compushady_fastcall_uint32(PyObject *py_arg, uint32_t *value)
+{
+	if (!py_arg)
+	{
+		return true;
+	}
+	const unsigned long long new_value = PyLong_AsUnsignedLongLongMask(py_arg);
+	if (new_value == (unsigned long long)-1 && PyErr_Occurred())
+	{
+		return false;
+	}
+	*value = (uint32_t)new_value;
+	return true;
+}
+
+// like the 'K' format of PyArg_ParseTuple (a missing argument keeps the default value)
+bool compushady_fastcall_uint64(PyObject *py_arg, uint64_t *value)
+{
+	if (!py_arg)
+	{
+		return true;
+	}
+	const unsigned long long new_value = PyLong_AsUnsignedLongLongMask(py_arg);
+	if (new_value == (unsigned long long)-1 && PyErr_Occurred())
+	{
+		return false;
+	}
+	*value = new_value;
+	return true;
+}
+
+// like the 'y*' format of PyArg_ParseTuple (a missing argument leaves the view empty)
+bool compushady_fastcall_buffer(PyObject *py_arg, Py_buffer *view)
+{
+	if (!py_arg)
+	{
+		return true;
+	}
+	if (PyUnicode_Check(py_arg))
+	{
+		PyErr_Format(PyExc_TypeError, "a bytes-like object is required, not 'str'");
+		return false;
+	}
+	return PyObject_GetBuffer(py_arg, view, PyBUF_SIMPLE) == 0;
+}
+
+static bool compushady_file_transfer_range(const int fd, char *data, uint64_t file_offset, uint64_t size, const bool to_file, int *error)
+{
+#ifdef _WIN32
+	HANDLE handle = (HANDLE)_get_osfhandle(fd);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		*error = EBADF;
+		return false;
+	}
+#endif
+	while (size > 0)
+	{
+		// keep every single call below 1GB
+		const uint64_t amount = size > 0x40000000 ? 0x40000000 : size;
+#ifdef _WIN32
+		// the offset in the OVERLAPPED structure makes ReadFile/WriteFile positional (like pread/pwrite)
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = (DWORD)(file_offset & 0xFFFFFFFF);
+		overlapped.OffsetHigh = (DWORD)(file_offset >> 32);
+		DWORD transferred = 0;
+		const BOOL ret = to_file ? WriteFile(handle, data, (DWORD)amount, &transferred, &overlapped) : ReadFile(handle, data, (DWORD)amount, &transferred, &overlapped);
+		if (!ret)
+		{
+			*error = EIO;
+			return false;
+		}
+#else
+		const ssize_t transferred = to_file ? pwrite(fd, data, (size_t)amount, (off_t)file_offset) : pread(fd, data, (size_t)amount, (off_t)file_offset);
+		if (transferred < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			*error = errno;
+			return false;
+		}
+#endif
+		// the end of the file has been reached before the requested size
+		if (transferred == 0)
+		{
+			*error = EIO;
+			return false;
+		}
+		data += transferred;
+		file_offset += transferred;
+		size -= transferred;
+	}
+	return true;
+}
+
+bool compushady_file_transfer(const int fd, char *data, const uint64_t file_offset, const uint64_t size, const bool to_file)
+{
+	// every thread gets at least 16MB
+	const uint64_t min_slice = 16 * 1024 * 1024;
+	uint64_t num_threads = std::thread::hardware_concurrency();
+	if (num_threads > 8)
+	{
+		num_threads = 8;
+	}
+	if (num_threads > (size + min_slice - 1) / min_slice)
+	{
+		num_threads = (size + min_slice - 1) / min_slice;
+	}
+
+	int error = 0;
+	if (num_threads <= 1)
+	{
+		if (!compushady_file_transfer_range(fd, data, file_offset, size, to_file, &error))
+		{
+			errno = error;
+			return false;
+		}
+		return true;
+	}
+
+	// slices are page aligned (the last one gets the remainder)
+	const uint64_t slice = COMPUSHADY_ALIGN((size + num_threads - 1) / num_threads, 4096);
+	std::vector<std::thread> threads;
+	std::vector<int> errors(num_threads, 0);
+	for (uint64_t i = 0; i < num_threads && i * slice < size; i++)
+	{
+		const uint64_t offset = i * slice;
+		const uint64_t amount = offset + slice > size ? size - offset : slice;
+		try
+		{
+			threads.emplace_back(compushady_file_transfer_range, fd, data + offset, file_offset + offset, amount, to_file, &errors[i]);
+		}
+		catch (const std::system_error &)
+		{
+			// unable to spawn a new thread, do the work in the current one
+			compushady_file_transfer_range(fd, data + offset, file_offset + offset, amount, to_file, &errors[i]);
+		}
+	}
+
+	for (std::thread &thread : threads)
+	{
+		thread.join();
+	}
+
+	for (const int thread_error : errors)
+	{
+		if (thread_error)
+		{
+			errno = thread_error;
+			return false;
+		}
+	}
+	return true;
+}
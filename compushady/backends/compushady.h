@@ -24,6 +24,11 @@
 #define COMPUSHADY_SAMPLER_ADDRESS_MODE_MIRROR 1
 #define COMPUSHADY_SAMPLER_ADDRESS_MODE_CLAMP 2
 
+#define COMPUSHADY_USAGE_READ_ONLY 1
+#define COMPUSHADY_USAGE_STORAGE 2
+#define COMPUSHADY_USAGE_TRANSFER 4
+#define COMPUSHADY_USAGE_ALL (COMPUSHADY_USAGE_READ_ONLY | COMPUSHADY_USAGE_STORAGE | COMPUSHADY_USAGE_TRANSFER)
+
 #define R32G32B32A32_FLOAT 2
 #define R32G32B32A32_UINT 3
 #define R32G32B32A32_SINT 4
@@ -84,9 +89,40 @@ PyObject *compushady_backend_init(PyModuleDef *py_module_def,
 								  PyTypeObject *sampler_type, PyMemberDef *sampler_members, PyMethodDef *sampler_methods,
 								  PyTypeObject *heap_type, PyMemberDef *heap_members, PyMethodDef *heap_methods);
 
+/*
+ * Hot methods use the METH_FASTCALL calling convention (no args tuple/kwargs dict) when available.
+ * The arguments are mapped to slots (following kwlist order) by compushady_fastcall_parse and then converted.
+ */
+#if PY_VERSION_HEX >= 0x03070000
+#define COMPUSHADY_METH_FASTCALL (METH_FASTCALL | METH_KEYWORDS)
+#define COMPUSHADY_FASTCALL_ARGS PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames
+#define COMPUSHADY_FASTCALL_PASS args, nargs, kwnames
+#else
+#define COMPUSHADY_METH_FASTCALL (METH_VARARGS | METH_KEYWORDS)
+#define COMPUSHADY_FASTCALL_ARGS PyObject *args, PyObject *kwds
+#define COMPUSHADY_FASTCALL_PASS args, kwds
+#endif
+
+bool compushady_fastcall_parse(const char *name, const char *const *kwlist, const Py_ssize_t required, PyObject **slots, COMPUSHADY_FASTCALL_ARGS);
+
+bool compushady_fastcall_uint32(PyObject *py_arg, uint32_t *value);
+
+bool compushady_fastcall_uint64(PyObject *py_arg, uint64_t *value);
+
+bool compushady_fastcall_buffer(PyObject *py_arg, Py_buffer *view);
+
+/*
+ * Reads (or writes, when to_file is true) size bytes between a file descriptor (at file_offset) and memory,
+ * splitting the work among multiple threads. It does not use Python APIs, so it can run without the GIL.
+ * On failure it returns false with errno set.
+ */
+bool compushady_file_transfer(const int fd, char *data, const uint64_t file_offset, const uint64_t size, const bool to_file);
+
 size_t compushady_get_size_by_pitch(const size_t pitch, const size_t width, const size_t height, const size_t depth, const size_t bytes_per_pixel);
 
-bool compushady_check_copy_to(const bool src_is_buffer, const bool dst_is_buffer, const uint64_t size, const uint64_t src_offset, const uint64_t dst_offset, const uint64_t src_size, const uint64_t dst_size, const uint32_t src_x, const uint32_t src_y, const uint32_t src_z, const uint32_t src_slice, const uint32_t src_slices, const uint32_t dst_slice, const uint32_t dst_slices, const uint32_t src_width, const uint32_t src_height, const uint32_t src_depth, const uint32_t dst_width, const uint32_t dst_height, const uint32_t dst_depth, uint32_t *dst_x, uint32_t *dst_y, uint32_t *dst_z, uint32_t *width, uint32_t *height, uint32_t *depth);
+uint32_t compushady_get_max_mips(const uint32_t width, const uint32_t height, const uint32_t depth);
+
+bool compushady_check_copy_to(const bool src_is_buffer, const bool dst_is_buffer, const uint64_t size, const uint64_t src_offset, const uint64_t dst_offset, const uint64_t src_size, const uint64_t dst_size, const uint32_t src_x, const uint32_t src_y, const uint32_t src_z, const uint32_t src_slice, const uint32_t src_slices, const uint32_t dst_slice, const uint32_t dst_slices, const uint32_t src_width, const uint32_t src_height, const uint32_t src_depth, const uint32_t dst_width, const uint32_t dst_height, const uint32_t dst_depth, uint32_t *dst_x, uint32_t *dst_y, uint32_t *dst_z, uint32_t *width, uint32_t *height, uint32_t *depth, const uint32_t bytes_per_pixel, const uint32_t row_pitch_alignment, uint64_t *buffer_row_pitch, uint64_t *buffer_slice_pitch);
 
 template <typename T, typename U>
 bool compushady_check_descriptors(PyTypeObject *py_resource_type, PyObject *py_cbv, std::vector<T *> &cbv, PyObject *py_srv, std::vector<T *> &srv, PyObject *py_uav, std::vector<T *> &uav, PyTypeObject *py_sampler_type, PyObject *py_samplers, std::vector<U *> &samplers)
@@ -859,9 +859,15 @@ static PyObject *d3d12_Device_create_texture1d(d3d12_Device *self, PyObject *arg
 	SIZE_T heap_offset;
 	UINT slices;
 	PyObject *py_sparse;
-	if (!PyArg_ParseTuple(args, "IiOKIO", &width, &format, &py_heap, &heap_offset, &slices, &py_sparse))
+	UINT mips = 1;
+	if (!PyArg_ParseTuple(args, "IiOKIO|I", &width, &format, &py_heap, &heap_offset, &slices, &py_sparse, &mips))
 		return NULL;
 
+	if (mips != 1)
+	{
+		return PyErr_Format(PyExc_ValueError, "mips are not supported by this backend");
+	}
+
 	if (width == 0)
 	{
 		return PyErr_Format(PyExc_ValueError, "invalid width");
@@ -1085,9 +1091,15 @@ static PyObject *d3d12_Device_create_texture2d(d3d12_Device *self, PyObject *arg
 	SIZE_T heap_offset;
 	UINT slices;
 	PyObject *py_sparse;
-	if (!PyArg_ParseTuple(args, "IIiOKIO", &width, &height, &format, &py_heap, &heap_offset, &slices, &py_sparse))
+	UINT mips = 1;
+	if (!PyArg_ParseTuple(args, "IIiOKIO|I", &width, &height, &format, &py_heap, &heap_offset, &slices, &py_sparse, &mips))
 		return NULL;
 
+	if (mips != 1)
+	{
+		return PyErr_Format(PyExc_ValueError, "mips are not supported by this backend");
+	}
+
 	if (width == 0)
 	{
 		return PyErr_Format(PyExc_ValueError, "invalid width");
@@ -1240,9 +1252,15 @@ static PyObject *d3d12_Device_create_texture3d(d3d12_Device *self, PyObject *arg
 	PyObject *py_heap;
 	SIZE_T heap_offset;
 	PyObject *py_sparse;
-	if (!PyArg_ParseTuple(args, "IIIiOKO", &width, &height, &depth, &format, &py_heap, &heap_offset, &py_sparse))
+	UINT mips = 1;
+	if (!PyArg_ParseTuple(args, "IIIiOKO|I", &width, &height, &depth, &format, &py_heap, &heap_offset, &py_sparse, &mips))
 		return NULL;
 
+	if (mips != 1)
+	{
+		return PyErr_Format(PyExc_ValueError, "mips are not supported by this backend");
+	}
+
 	if (width == 0)
 	{
 		return PyErr_Format(PyExc_ValueError, "invalid width");
@@ -1702,7 +1720,9 @@ static PyObject *d3d12_Device_create_compute(d3d12_Device *self, PyObject *args,
 	compute_pipeline_desc.CS.pShaderBytecode = view.buf;
 	compute_pipeline_desc.CS.BytecodeLength = view.len;
 
+	Py_BEGIN_ALLOW_THREADS;
 	hr = py_device->device->CreateComputePipelineState(&compute_pipeline_desc, __uuidof(ID3D12PipelineState), (void **)&py_compute->pipeline);
+	Py_END_ALLOW_THREADS;
 	if (hr != S_OK)
 	{
 		PyBuffer_Release(&view);
@@ -2003,6 +2023,52 @@ static PyObject *d3d12_Resource_readback_to_buffer(d3d12_Resource *self, PyObjec
 	Py_RETURN_NONE;
 }
 
+static PyObject *d3d12_Resource_file_transfer(d3d12_Resource *self, PyObject *args, const bool to_file)
+{
+	int fd;
+	UINT64 file_offset;
+	UINT64 size;
+	UINT64 offset;
+	if (!PyArg_ParseTuple(args, "iKKK", &fd, &file_offset, &size, &offset))
+		return NULL;
+
+	if (offset + size > self->size)
+	{
+		return PyErr_Format(PyExc_ValueError, "requested range out of bounds: (offset %llu) %llu (expected no more than %llu)", offset, size, self->size);
+	}
+
+	char *mapped_data;
+	HRESULT hr = self->resource->Map(0, NULL, (void **)&mapped_data);
+	if (hr != S_OK)
+	{
+		return d3d_generate_exception(PyExc_Exception, hr, "Unable to Map() ID3D12Resource1");
+	}
+
+	bool success;
+	Py_BEGIN_ALLOW_THREADS;
+	success = compushady_file_transfer(fd, mapped_data + offset, file_offset, size, to_file);
+	Py_END_ALLOW_THREADS;
+
+	self->resource->Unmap(0, NULL);
+
+	if (!success)
+	{
+		return PyErr_SetFromErrno(PyExc_OSError);
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *d3d12_Resource_upload_file(d3d12_Resource *self, PyObject *args)
+{
+	return d3d12_Resource_file_transfer(self, args, false);
+}
+
+static PyObject *d3d12_Resource_readback_to_file(d3d12_Resource *self, PyObject *args)
+{
+	return d3d12_Resource_file_transfer(self, args, true);
+}
+
 static PyObject *d3d12_Resource_copy_to(d3d12_Resource *self, PyObject *args)
 {
 	PyObject *py_destination;
@@ -2020,7 +2086,9 @@ static PyObject *d3d12_Resource_copy_to(d3d12_Resource *self, PyObject *args)
 	UINT dst_z;
 	UINT src_slice;
 	UINT dst_slice;
-	if (!PyArg_ParseTuple(args, "OKKKIIIIIIIIIII", &py_destination, &size, &src_offset, &dst_offset, &width, &height, &depth, &src_x, &src_y, &src_z, &dst_x, &dst_y, &dst_z, &src_slice, &dst_slice))
+	UINT64 buffer_row_pitch = 0;
+	UINT64 buffer_slice_pitch = 0;
+	if (!PyArg_ParseTuple(args, "OKKKIIIIIIIIIII|KK", &py_destination, &size, &src_offset, &dst_offset, &width, &height, &depth, &src_x, &src_y, &src_z, &dst_x, &dst_y, &dst_z, &src_slice, &dst_slice, &buffer_row_pitch, &buffer_slice_pitch))
 		return NULL;
 
 	int ret = PyObject_IsInstance(py_destination, (PyObject *)&d3d12_Resource_Type);
@@ -2035,22 +2103,36 @@ static PyObject *d3d12_Resource_copy_to(d3d12_Resource *self, PyObject *args)
 
 	d3d12_Resource *dst_resource = (d3d12_Resource *)py_destination;
 
-	if (size == 0)
+	bool buffer_to_buffer_copy = (self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER) && (dst_resource->dimension == D3D12_RESOURCE_DIMENSION_BUFFER);
+
+	if (size == 0 && buffer_to_buffer_copy)
 	{
 		size = self->size;
 	}
 
-	bool texture_to_texture_copy = (self->dimension != D3D12_RESOURCE_DIMENSION_BUFFER) && (dst_resource->dimension != D3D12_RESOURCE_DIMENSION_BUFFER);
+	d3d12_Resource *texture_resource = self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? dst_resource : self;
+	UINT bytes_per_pixel = buffer_to_buffer_copy ? 1 : (UINT)dxgi_pixels_sizes[texture_resource->format];
 	if (!compushady_check_copy_to(self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER,
 								  dst_resource->dimension == D3D12_RESOURCE_DIMENSION_BUFFER, size, src_offset, dst_offset, self->size, dst_resource->size,
 								  src_x, src_y, src_z, src_slice, self->slices, dst_slice, dst_resource->slices,
 								  self->footprint.Footprint.Width, self->footprint.Footprint.Height, self->footprint.Footprint.Depth,
 								  dst_resource->footprint.Footprint.Width, dst_resource->footprint.Footprint.Height, dst_resource->footprint.Footprint.Depth,
-								  &dst_x, &dst_y, &dst_z, &width, &height, &depth))
+								  &dst_x, &dst_y, &dst_z, &width, &height, &depth,
+								  bytes_per_pixel, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT, &buffer_row_pitch, &buffer_slice_pitch))
 	{
 		return NULL;
 	}
 
+	// placed footprints must start at D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT (512 bytes) offsets
+	if (!buffer_to_buffer_copy && (self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER || dst_resource->dimension == D3D12_RESOURCE_DIMENSION_BUFFER))
+	{
+		const UINT64 buffer_offset = self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? src_offset : dst_offset;
+		if (buffer_offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT)
+		{
+			return PyErr_Format(PyExc_ValueError, "buffer offset (%llu) of a buffer<->texture copy must be aligned to %u bytes", buffer_offset, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+		}
+	}
+
 	D3D12_RESOURCE_BARRIER barriers[2] = {};
 	barriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
 	barriers[0].Transition.pResource = self->resource;
@@ -2083,12 +2165,20 @@ static PyObject *d3d12_Resource_copy_to(d3d12_Resource *self, PyObject *args)
 	}
 	else // texture copy
 	{
+		// the buffer side of the copy is described by a footprint matching the requested box and pitches
+		D3D12_PLACED_SUBRESOURCE_FOOTPRINT buffer_footprint = {};
+		buffer_footprint.Footprint.Format = texture_resource->footprint.Footprint.Format;
+		buffer_footprint.Footprint.Width = width;
+		buffer_footprint.Footprint.Height = (UINT)(buffer_slice_pitch / buffer_row_pitch);
+		buffer_footprint.Footprint.Depth = depth;
+		buffer_footprint.Footprint.RowPitch = (UINT)buffer_row_pitch;
+
 		D3D12_TEXTURE_COPY_LOCATION dest_location = {};
 		dest_location.pResource = dst_resource->resource;
 		if (dst_resource->dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
 		{
 			dest_location.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-			dest_location.PlacedFootprint = self->footprint;
+			dest_location.PlacedFootprint = buffer_footprint;
 			dest_location.PlacedFootprint.Offset = dst_offset;
 		}
 		else
@@ -2107,7 +2197,7 @@ static PyObject *d3d12_Resource_copy_to(d3d12_Resource *self, PyObject *args)
 		if (self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
 		{
 			src_location.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-			src_location.PlacedFootprint = dst_resource->footprint;
+			src_location.PlacedFootprint = buffer_footprint;
 			src_location.PlacedFootprint.Offset = src_offset;
 		}
 		else
@@ -2122,13 +2212,28 @@ static PyObject *d3d12_Resource_copy_to(d3d12_Resource *self, PyObject *args)
 		}
 
 		D3D12_BOX box = {};
-		box.left = src_x;
-		box.right = src_x + width;
-		box.top = src_y;
-		box.bottom = src_y + height;
-		box.front = src_z;
-		box.back = src_z + depth;
-		self->py_device->command_list->CopyTextureRegion(&dest_location, dst_x, dst_y, dst_z, &src_location, texture_to_texture_copy ? &box : NULL);
+		if (self->dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		{
+			box.right = width;
+			box.bottom = height;
+			box.back = depth;
+		}
+		else
+		{
+			box.left = src_x;
+			box.right = src_x + width;
+			box.top = src_y;
+			box.bottom = src_y + height;
+			box.front = src_z;
+			box.back = src_z + depth;
+		}
+		if (dst_resource->dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		{
+			dst_x = 0;
+			dst_y = 0;
+			dst_z = 0;
+		}
+		self->py_device->command_list->CopyTextureRegion(&dest_location, dst_x, dst_y, dst_z, &src_location, &box);
 	}
 
 	if (reset_barrier0)
@@ -2253,6 +2358,8 @@ static PyMethodDef d3d12_Resource_methods[] = {
 	{"upload_chunked", (PyCFunction)d3d12_Resource_upload_chunked, METH_VARARGS, "Upload bytes to a GPU Resource with the given stride and a filler"},
 	{"readback", (PyCFunction)d3d12_Resource_readback, METH_VARARGS, "Readback bytes from a GPU Resource"},
 	{"readback_to_buffer", (PyCFunction)d3d12_Resource_readback_to_buffer, METH_VARARGS, "Readback into a buffer from a GPU Resource"},
+	{"upload_file", (PyCFunction)d3d12_Resource_upload_file, METH_VARARGS, "Upload a range of a file to a GPU Resource"},
+	{"readback_to_file", (PyCFunction)d3d12_Resource_readback_to_file, METH_VARARGS, "Readback a range of a GPU Resource to a file"},
 	{"readback2d", (PyCFunction)d3d12_Resource_readback2d, METH_VARARGS, "Readback bytes from a GPU Resource given pitch, width, height and pixel size"},
 	{"copy_to", (PyCFunction)d3d12_Resource_copy_to, METH_VARARGS, "Copy resource content to another resource"},
 	{"bind_tile", (PyCFunction)d3d12_Resource_bind_tile, METH_VARARGS, "Bind a sparse resource tile to a heap"},
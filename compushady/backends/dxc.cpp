@@ -34,7 +34,8 @@ static PyObject *dxc_compile(PyObject *self, PyObject *args)
 	PyObject *py_entry_point;
 	int shader_binary_type;
 	PyObject *py_target;
-	if (!PyArg_ParseTuple(args, "s*UiU", &view, &py_entry_point, &shader_binary_type, &py_target))
+	PyObject *py_target_env = NULL;
+	if (!PyArg_ParseTuple(args, "s*UiU|U", &view, &py_entry_point, &shader_binary_type, &py_target, &py_target_env))
 		return NULL;
 
 	static DxcCreateInstanceProc dxcompiler_lib_create_instance_proc = NULL;
@@ -107,10 +108,35 @@ static PyObject *dxc_compile(PyObject *self, PyObject *args)
 		return NULL;
 	}
 
+	// the SPIR-V target environment (e.g. vulkan1.1 for wave intrinsics, requiring SPIR-V 1.3)
+	wchar_t *target_env = NULL;
+	if (py_target_env)
+	{
+		PyObject *py_target_env_argument = PyUnicode_FromFormat("-fspv-target-env=%U", py_target_env);
+		if (py_target_env_argument)
+		{
+			target_env = PyUnicode_AsWideCharString(py_target_env_argument, NULL);
+			Py_DECREF(py_target_env_argument);
+		}
+		if (!target_env)
+		{
+			PyMem_Free(target);
+			PyMem_Free(entry_point);
+			blob_source->Release();
+			dxc_compiler->Release();
+			dxc_library->Release();
+			return NULL;
+		}
+	}
+
 	std::vector<const wchar_t *> arguments;
 	if (shader_binary_type == COMPUSHADY_SHADER_BINARY_TYPE_SPIRV || shader_binary_type == COMPUSHADY_SHADER_BINARY_TYPE_MSL || shader_binary_type == COMPUSHADY_SHADER_BINARY_TYPE_GLSL)
 	{
 		arguments.push_back(L"-spirv");
+		if (target_env)
+		{
+			arguments.push_back(target_env);
+		}
 		arguments.push_back(L"-fvk-auto-shift-bindings");
 		arguments.push_back(L"-fvk-t-shift");
 		arguments.push_back(L"1024");
@@ -130,6 +156,10 @@ static PyObject *dxc_compile(PyObject *self, PyObject *args)
 
 	PyMem_Free(target);
 	PyMem_Free(entry_point);
+	if (target_env)
+	{
+		PyMem_Free(target_env);
+	}
 
 	if (hr == S_OK)
 	{
@@ -1068,8 +1068,13 @@ static PyObject* metal_Device_create_compute(metal_Device* self, PyObject* args,
         return NULL;
     }
 
-    py_compute->compute_pipeline_state =
+    // the pipeline compilation can be slow, Compute objects can be built in parallel by multiple threads
+    id<MTLComputePipelineState> compute_pipeline_state;
+    Py_BEGIN_ALLOW_THREADS;
+    compute_pipeline_state =
         [py_device->device newComputePipelineStateWithFunction:mtl_function->function error:nil];
+    Py_END_ALLOW_THREADS;
+    py_compute->compute_pipeline_state = compute_pipeline_state;
     if (!py_compute->compute_pipeline_state)
     {
         Py_DECREF(py_compute);
@@ -1166,9 +1171,15 @@ static PyObject* metal_Device_create_texture2d(metal_Device* self, PyObject* arg
     size_t heap_offset;
     uint32_t slices;
     PyObject* py_sparse;
-    if (!PyArg_ParseTuple(args, "IIiOKIO", &width, &height, &format, &py_heap, &heap_offset, &slices, &py_sparse))
+    uint32_t mips = 1;
+    if (!PyArg_ParseTuple(args, "IIiOKIO|I", &width, &height, &format, &py_heap, &heap_offset, &slices, &py_sparse, &mips))
         return NULL;
 
+    if (mips != 1)
+    {
+        return PyErr_Format(PyExc_ValueError, "mips are not supported by this backend");
+    }
+
     if (width == 0)
     {
         return PyErr_Format(PyExc_ValueError, "invalid width");
@@ -1278,9 +1289,15 @@ static PyObject* metal_Device_create_texture1d(metal_Device* self, PyObject* arg
     size_t heap_offset;
     uint32_t slices;
     PyObject* py_sparse;
-    if (!PyArg_ParseTuple(args, "IiOKIO", &width, &format, &py_heap, &heap_offset, &slices, &py_sparse))
+    uint32_t mips = 1;
+    if (!PyArg_ParseTuple(args, "IiOKIO|I", &width, &format, &py_heap, &heap_offset, &slices, &py_sparse, &mips))
         return NULL;
 
+    if (mips != 1)
+    {
+        return PyErr_Format(PyExc_ValueError, "mips are not supported by this backend");
+    }
+
     if (width == 0)
     {
 	return PyErr_Format(PyExc_ValueError, "invalid width");
@@ -1391,9 +1408,15 @@ static PyObject* metal_Device_create_texture3d(metal_Device* self, PyObject* arg
     PyObject* py_heap;
     size_t heap_offset;
     PyObject* py_sparse;
-    if (!PyArg_ParseTuple(args, "IIIiOKO", &width, &height, &depth, &format, &py_heap, &heap_offset, &py_sparse))
+    uint32_t mips = 1;
+    if (!PyArg_ParseTuple(args, "IIIiOKO|I", &width, &height, &depth, &format, &py_heap, &heap_offset, &py_sparse, &mips))
         return NULL;
 
+    if (mips != 1)
+    {
+        return PyErr_Format(PyExc_ValueError, "mips are not supported by this backend");
+    }
+
     if (width == 0)
     {
         return PyErr_Format(PyExc_ValueError, "invalid width");
@@ -1817,6 +1840,47 @@ static PyObject* metal_Resource_readback_to_buffer(metal_Resource* self, PyObjec
     Py_RETURN_NONE;
 }
 
+static PyObject* metal_Resource_file_transfer(metal_Resource* self, PyObject* args, const bool to_file)
+{
+    int fd;
+    uint64_t file_offset;
+    uint64_t size;
+    uint64_t offset;
+    if (!PyArg_ParseTuple(args, "iKKK", &fd, &file_offset, &size, &offset))
+        return NULL;
+
+    if (offset + size > self->size)
+    {
+        return PyErr_Format(PyExc_ValueError,
+            "requested range out of bounds: (offset %llu) %llu (expected no more than %llu)",
+            offset, size, self->size);
+    }
+
+    char* mapped_data = (char*)[self->buffer contents];
+
+    bool success;
+    Py_BEGIN_ALLOW_THREADS;
+    success = compushady_file_transfer(fd, mapped_data + offset, file_offset, size, to_file);
+    Py_END_ALLOW_THREADS;
+
+    if (!success)
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* metal_Resource_upload_file(metal_Resource* self, PyObject* args)
+{
+    return metal_Resource_file_transfer(self, args, false);
+}
+
+static PyObject* metal_Resource_readback_to_file(metal_Resource* self, PyObject* args)
+{
+    return metal_Resource_file_transfer(self, args, true);
+}
+
 static PyObject* metal_Resource_copy_to(metal_Resource* self, PyObject* args)
 {
     PyObject* py_destination;
@@ -1834,7 +1898,9 @@ static PyObject* metal_Resource_copy_to(metal_Resource* self, PyObject* args)
     uint32_t dst_z;
     uint32_t src_slice;
     uint32_t dst_slice;
-    if (!PyArg_ParseTuple(args, "OKKKIIIIIIIIIII", &py_destination, &size, &src_offset, &dst_offset, &width, &height, &depth, &src_x, &src_y, &src_z, &dst_x, &dst_y, &dst_z, &src_slice, &dst_slice))
+    uint64_t buffer_row_pitch = 0;
+    uint64_t buffer_slice_pitch = 0;
+    if (!PyArg_ParseTuple(args, "OKKKIIIIIIIIIII|KK", &py_destination, &size, &src_offset, &dst_offset, &width, &height, &depth, &src_x, &src_y, &src_z, &dst_x, &dst_y, &dst_z, &src_slice, &dst_slice, &buffer_row_pitch, &buffer_slice_pitch))
         return NULL;
 
     int ret = PyObject_IsInstance(py_destination, (PyObject*)&metal_Resource_Type);
@@ -1847,19 +1913,23 @@ static PyObject* metal_Resource_copy_to(metal_Resource* self, PyObject* args)
         return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
     }
 
-    if (size == 0)
+    metal_Resource* dst_resource = (metal_Resource*)py_destination;
+
+    if (size == 0 && self->buffer && dst_resource->buffer)
     {
         size = self->size;
     }
 
-    metal_Resource* dst_resource = (metal_Resource*)py_destination;
+    metal_Resource* texture_resource = self->buffer ? dst_resource : self;
+    const uint32_t bytes_per_pixel = texture_resource->texture ? texture_resource->row_pitch / texture_resource->width : 1;
 
     if (!compushady_check_copy_to(self->buffer,
                                   dst_resource->buffer, size, src_offset, dst_offset, self->size, dst_resource->size,
                                   src_x, src_y, src_z, src_slice, self->slices, dst_slice, dst_resource->slices,
                                   self->width, self->height, self->depth,
                                   dst_resource->width, dst_resource->height, dst_resource->depth,
-                                  &dst_x, &dst_y, &dst_z, &width, &height, &depth))
+                                  &dst_x, &dst_y, &dst_z, &width, &height, &depth,
+                                  bytes_per_pixel, bytes_per_pixel, &buffer_row_pitch, &buffer_slice_pitch))
     {
         return NULL;
     }
@@ -1879,26 +1949,25 @@ static PyObject* metal_Resource_copy_to(metal_Resource* self, PyObject* args)
     {
         [blit_command_encoder copyFromBuffer:self->buffer
                                 sourceOffset:src_offset
-                           sourceBytesPerRow:dst_resource->row_pitch
-                         sourceBytesPerImage:dst_resource->row_pitch * dst_resource->height
-                                  sourceSize:MTLSizeMake(dst_resource->width, dst_resource->height,
-                                                 dst_resource->depth)
+                           sourceBytesPerRow:buffer_row_pitch
+                         sourceBytesPerImage:buffer_slice_pitch
+                                  sourceSize:MTLSizeMake(width, height, depth)
                                    toTexture:dst_resource->texture
                             destinationSlice:dst_slice
                             destinationLevel:0
-                           destinationOrigin:MTLOriginMake(0, 0, 0)];
+                           destinationOrigin:MTLOriginMake(dst_x, dst_y, dst_z)];
     }
     else if (dst_resource->buffer) // image to buffer
     {
         [blit_command_encoder copyFromTexture:self->texture
                                   sourceSlice:src_slice
                                   sourceLevel:0
-                                 sourceOrigin:MTLOriginMake(0, 0, 0)
-                                   sourceSize:MTLSizeMake(self->width, self->height, self->depth)
+                                 sourceOrigin:MTLOriginMake(src_x, src_y, src_z)
+                                   sourceSize:MTLSizeMake(width, height, depth)
                                      toBuffer:dst_resource->buffer
                             destinationOffset:dst_offset
-                       destinationBytesPerRow:self->row_pitch
-                     destinationBytesPerImage:self->row_pitch * self->height];
+                       destinationBytesPerRow:buffer_row_pitch
+                     destinationBytesPerImage:buffer_slice_pitch];
     }
     else // image to image
     {
@@ -1937,6 +2006,10 @@ static PyMethodDef metal_Resource_methods[] = {
         "Readback bytes from a GPU Resource given pitch, width, height and pixel size"},
     { "readback_to_buffer", (PyCFunction)metal_Resource_readback_to_buffer, METH_VARARGS,
         "Readback into a buffer from a GPU Resource" },
+    { "upload_file", (PyCFunction)metal_Resource_upload_file, METH_VARARGS,
+        "Upload a range of a file to a GPU Resource" },
+    { "readback_to_file", (PyCFunction)metal_Resource_readback_to_file, METH_VARARGS,
+        "Readback a range of a GPU Resource to a file" },
     { "copy_to", (PyCFunction)metal_Resource_copy_to, METH_VARARGS,
         "Copy resource content to another resource" },
     { NULL, NULL, 0, NULL } /* Sentinel */
@@ -2000,7 +2073,10 @@ static PyObject* compushady_msl_compile(PyObject* self, PyObject* args)
 
     NSError* error = nil;
 
-    id<MTLLibrary> library = [device newLibraryWithSource:source options:NULL error:&error];
+    id<MTLLibrary> library;
+    Py_BEGIN_ALLOW_THREADS;
+    library = [device newLibraryWithSource:source options:NULL error:&error];
+    Py_END_ALLOW_THREADS;
     if (!library)
     {
         PyObject* py_exc = PyErr_Format(PyExc_Exception, "unable to compile shader: %s",
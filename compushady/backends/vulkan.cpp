@@ -4,6 +4,9 @@
 
 #include "structmember.h"
 #ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include <Windows.h>
 #include <vulkan/vulkan_win32.h>
 #else
@@ -16,15 +19,23 @@
 #endif
 #endif
 
+#include <set>
 #include <string>
 #include <unordered_map>
 
 #include "compushady.h"
 
+#include "spirv_cross/spirv_cross.hpp"
+
 #define VK_FORMAT(x, size) vulkan_formats[x] = {VK_FORMAT_##x, size}
 #define VK_FORMAT_FLOAT(x, size) vulkan_formats[x##_FLOAT] = {VK_FORMAT_##x##_SFLOAT, size}
 #define VK_FORMAT_SRGB(x, size) vulkan_formats[x##_UNORM_SRGB] = {VK_FORMAT_##x##_SRGB, size}
 
+#define VULKAN_BINDLESS_HEAP_SET 1
+#define VULKAN_BINDLESS_HEAP_SIZE 4096
+#define VULKAN_CONSTANTS_RING_SIZE (4 * 1024 * 1024)
+#define VULKAN_MAX_SUBMISSIONS 8
+
 static std::unordered_map<uint32_t, std::pair<VkFormat, uint32_t>> vulkan_formats;
 static std::vector<std::string> vulkan_debug_messages;
 
@@ -37,6 +48,65 @@ static bool vulkan_supports_swapchain = false;
 static bool vulkan_supports_wayland = false;
 #endif
 
+/*
+ * Vulkan objects released by Python while the GPU may still be using them.
+ * They are destroyed once the submission with the given serial has completed.
+ */
+typedef struct vulkan_DeferredDeletion
+{
+    uint64_t serial;
+    VkImage image;
+    VkImageView image_view;
+    VkImageView storage_image_view;
+    VkBuffer buffer;
+    VkBufferView buffer_view;
+    VkDeviceMemory memory;
+    VkSampler sampler;
+    VkPipeline pipeline;
+    VkPipelineLayout pipeline_layout;
+    VkDescriptorPool descriptor_pool;
+    VkDescriptorSetLayout descriptor_set_layout;
+    VkShaderModule shader_module;
+    bool has_bindless_index;
+    uint32_t bindless_index;
+} vulkan_DeferredDeletion;
+
+/*
+ * Buffers released by Python and kept by the device for being reused by the next matching create_buffer().
+ */
+typedef struct vulkan_CachedBuffer
+{
+    uint64_t serial;
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    VkBufferView buffer_view;
+    uint64_t buffer_view_range;
+    uint64_t heap_size;
+    uint64_t device_address;
+    int heap_type;
+    VkFormat format;
+    uint32_t usage;
+} vulkan_CachedBuffer;
+
+/*
+ * A command buffer with the fence signaled by its last submission (serial).
+ */
+typedef struct vulkan_Submission
+{
+    VkCommandBuffer command_buffer;
+    VkFence fence;
+    uint64_t serial;
+} vulkan_Submission;
+
+/*
+ * A VkDeviceMemory mapped by the running upload/readback calls (reference counted).
+ */
+typedef struct vulkan_Mapping
+{
+    char *data;
+    uint32_t references;
+} vulkan_Mapping;
+
 typedef struct vulkan_Device
 {
     PyObject_HEAD;
@@ -58,6 +128,57 @@ typedef struct vulkan_Device
     VkPhysicalDeviceFeatures features;
     bool supports_bindless;
     bool supports_sparse;
+    VkSemaphore sparse_semaphores[2];
+    uint32_t sparse_semaphore_index;
+    bool sparse_pending;
+    bool supports_buffer_device_address;
+#ifdef VK_KHR_buffer_device_address
+    PFN_vkGetBufferDeviceAddressKHR get_buffer_device_address;
+#endif
+    bool supports_sliced_view_of_3d;
+    uint64_t supported_features;
+    uint64_t requested_features;
+    uint64_t disabled_features;
+    PyObject *py_features;
+    uint32_t subgroup_size;
+    uint32_t min_subgroup_size;
+    uint32_t max_subgroup_size;
+    PyObject *py_subgroup_operations;
+    bool supports_subgroup_size_control;
+    uint32_t max_compute_shared_memory_size;
+    uint32_t max_compute_work_group_invocations;
+    uint32_t max_compute_work_group_count[3];
+    uint32_t max_compute_work_group_size[3];
+    uint32_t max_uniform_buffer_range;
+    uint32_t min_uniform_buffer_offset_alignment;
+    uint32_t min_storage_buffer_offset_alignment;
+    uint32_t min_texel_buffer_offset_alignment;
+    VkDescriptorSetLayout bindless_heap_layout;
+    VkDescriptorPool bindless_heap_pool;
+    VkDescriptorSet bindless_heap_set;
+    uint32_t bindless_heap_next;
+    std::vector<uint32_t> *bindless_heap_free;
+    bool supports_push_descriptors;
+    uint32_t max_push_descriptors;
+#ifdef VK_KHR_push_descriptor
+    PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set;
+#endif
+    VkBuffer constants_ring_buffer;
+    VkDeviceMemory constants_ring_memory;
+    uint8_t *constants_ring_mapped;
+    uint32_t constants_ring_offset;
+    std::vector<VkImageMemoryBarrier> *pending_image_barriers;
+    uint64_t submitted_serial;
+    uint64_t completed_serial;
+    std::vector<vulkan_Submission> *submissions;
+    size_t current_submission;
+    bool recording_batch;
+    std::vector<vulkan_DeferredDeletion> *deferred_deletions;
+    std::unordered_map<uint64_t, std::vector<vulkan_CachedBuffer>> *buffer_cache;
+    uint64_t buffer_cache_size;
+    uint64_t buffer_cache_hits;
+    uint64_t buffer_cache_misses;
+    std::unordered_map<VkDeviceMemory, vulkan_Mapping> *mappings;
 } vulkan_Device;
 
 typedef struct vulkan_Heap
@@ -96,6 +217,23 @@ typedef struct vulkan_Resource
     uint32_t tile_width;
     uint32_t tile_height;
     uint32_t tile_depth;
+    // every Heap a sparse resource has tiles bound to
+    std::vector<vulkan_Heap *> *tile_heaps;
+    uint32_t mips;
+    uint32_t mip;
+    VkImageViewType image_view_type;
+    VkImageView storage_image_view;
+    VkDescriptorImageInfo descriptor_storage_image_info;
+    struct vulkan_Resource *py_parent;
+    uint64_t device_address;
+    uint32_t bindless_index;
+    bool has_bindless_index;
+    uint64_t buffer_offset;
+    uint32_t first_slice;
+    uint32_t first_z;
+    uint32_t usage;
+    VkImageLayout layout;
+    uint64_t cache_size;
 } vulkan_Resource;
 
 typedef struct vulkan_Compute
@@ -114,6 +252,15 @@ typedef struct vulkan_Compute
     PyObject *py_samplers_list;
     uint32_t push_constant_size;
     uint32_t bindless;
+    uint32_t thread_group_size_x;
+    uint32_t thread_group_size_y;
+    uint32_t thread_group_size_z;
+    PyObject *py_bindings;
+    bool uses_bindless_heap;
+    bool push_descriptors;
+    std::vector<VkWriteDescriptorSet> *push_writes;
+    uint32_t constants_size;
+    std::vector<uint8_t> *constants;
 } vulkan_Compute;
 
 typedef struct vulkan_Swapchain
@@ -136,41 +283,99 @@ typedef struct vulkan_Sampler
     VkDescriptorImageInfo descriptor_image_info;
 } vulkan_Sampler;
 
-static const char *vulkan_get_spirv_entry_point(const uint32_t *words, uint64_t len)
+typedef struct vulkan_SPIRVReflection
 {
-    if (len < 20) // strip SPIR-V header
-        return NULL;
-    if (len % 4) // SPIR-V is a stream of 32bits words
-        return NULL;
-    if (words[0] != 0x07230203) // SPIR-V magic
-        return NULL;
+    std::string entry_point;
+    uint32_t thread_group_size[3];
+    uint32_t push_constant_size;
+    std::set<uint32_t> bindings;
+    std::set<uint32_t> non_readable_bindings;
+    bool uses_bindless_heap;
+} vulkan_SPIRVReflection;
 
-    uint64_t offset = 5; // (20 / 4 of SPIR-V header)
-    uint64_t words_num = len / 4;
-    while (offset < words_num)
+/*
+ * Parses the SPIR-V blob only once (using SPIRV-Cross) to extract the GLCompute entry point,
+ * the thread group size, the push constants block size and the bindings statically used by the shader.
+ */
+static bool vulkan_reflect_spirv(const uint32_t *words, const uint64_t len, vulkan_SPIRVReflection &reflection)
+{
+    if (len < 20 || (len % 4) || words[0] != 0x07230203) // SPIR-V header + magic
     {
-        uint32_t word = words[offset];
-        uint16_t opcode = word & 0xFFFF;
-        uint16_t size = word >> 16;
-        if (size == 0) // avoid loop!
-            return NULL;
-        if (opcode == 0x0F && (offset + size < words_num) && words[offset + 1] == 5) // OpEntryPoint(0x0F) + GLCompute(0x05)
+        PyErr_Format(PyExc_ValueError, "Invalid SPIR-V Shader, expected a GLCompute OpEntryPoint");
+        return false;
+    }
+
+    try
+    {
+        spirv_cross::Compiler compiler(words, (size_t)(len / 4));
+
+        bool found = false;
+        for (const spirv_cross::EntryPoint &entry_point : compiler.get_entry_points_and_stages())
         {
-            if (size > 3)
+            if (entry_point.execution_model == spv::ExecutionModelGLCompute)
+            {
+                reflection.entry_point = entry_point.name;
+                compiler.set_entry_point(entry_point.name, entry_point.execution_model);
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            PyErr_Format(PyExc_ValueError, "Invalid SPIR-V Shader, expected a GLCompute OpEntryPoint");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            const uint32_t size = compiler.get_execution_mode_argument(spv::ExecutionModeLocalSize, i);
+            reflection.thread_group_size[i] = size > 0 ? size : 1;
+        }
+
+        spirv_cross::ShaderResources resources = compiler.get_shader_resources(compiler.get_active_interface_variables());
+
+        reflection.push_constant_size = 0;
+        for (const spirv_cross::Resource &resource : resources.push_constant_buffers)
+        {
+            reflection.push_constant_size = (uint32_t)compiler.get_declared_struct_size(compiler.get_type(resource.base_type_id));
+        }
+
+        reflection.uses_bindless_heap = false;
+
+        auto track_bindings = [&](const spirv_cross::SmallVector<spirv_cross::Resource> &resources_list)
+        {
+            for (const spirv_cross::Resource &resource : resources_list)
             {
-                const char *name = (const char *)&words[offset + 3];
-                uint64_t max_namelen = (size - 3) * 4;
-                // check for trailing 0
-                for (uint64_t i = 0; i < max_namelen; i++)
+                // descriptor set 1 is the device bindless heap
+                if (compiler.get_decoration(resource.id, spv::DecorationDescriptorSet) == VULKAN_BINDLESS_HEAP_SET)
+                {
+                    reflection.uses_bindless_heap = true;
+                    continue;
+                }
+                const uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+                reflection.bindings.insert(binding);
+                if (compiler.has_decoration(resource.id, spv::DecorationNonReadable))
                 {
-                    if (name[i] == 0)
-                        return name;
+                    reflection.non_readable_bindings.insert(binding);
                 }
             }
-        }
-        offset += size;
+        };
+
+        track_bindings(resources.uniform_buffers);
+        track_bindings(resources.storage_buffers);
+        track_bindings(resources.storage_images);
+        track_bindings(resources.sampled_images);
+        track_bindings(resources.separate_images);
+        track_bindings(resources.separate_samplers);
     }
-    return NULL;
+    catch (const std::exception &e)
+    {
+        PyErr_Format(PyExc_ValueError, "Invalid SPIR-V Shader: %s", e.what());
+        return false;
+    }
+
+    return true;
 }
 
 /*
@@ -272,7 +477,7 @@ static uint32_t *vulkan_patch_spirv_unknown_uav(const uint32_t *words, uint64_t
 }
 
 static VkImage vulkan_create_image(VkDevice device, VkImageType image_type, VkFormat format,
-                                   const uint32_t width, const uint32_t height, const uint32_t depth, const uint32_t slices, const bool sparse)
+                                   const uint32_t width, const uint32_t height, const uint32_t depth, const uint32_t slices, const uint32_t mips, const bool sparse, const uint32_t usage)
 {
     VkImage image;
     VkImageCreateInfo image_create_info = {};
@@ -281,12 +486,19 @@ static VkImage vulkan_create_image(VkDevice device, VkImageType image_type, VkFo
     image_create_info.extent.height = height;
     image_create_info.extent.depth = depth;
     image_create_info.imageType = image_type;
-    image_create_info.mipLevels = 1;
+    image_create_info.mipLevels = mips;
     image_create_info.arrayLayers = slices;
     image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
     image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
     image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    image_create_info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    // leaving out STORAGE allows the driver to keep the image compressed
+    image_create_info.usage = 0;
+    if (usage & COMPUSHADY_USAGE_READ_ONLY)
+        image_create_info.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    if (usage & COMPUSHADY_USAGE_STORAGE)
+        image_create_info.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    if (usage & COMPUSHADY_USAGE_TRANSFER)
+        image_create_info.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     image_create_info.format = format;
     if (sparse)
     {
@@ -316,25 +528,308 @@ static VkImage vulkan_create_image(VkDevice device, VkImageType image_type, VkFo
     return image;
 }
 
+static void vulkan_Device_destroy(vulkan_Device *py_device, const vulkan_DeferredDeletion &deletion)
+{
+    VkDevice device = py_device->device;
+    if (deletion.has_bindless_index)
+        py_device->bindless_heap_free->push_back(deletion.bindless_index);
+    if (deletion.image_view)
+        vkDestroyImageView(device, deletion.image_view, NULL);
+    if (deletion.storage_image_view)
+        vkDestroyImageView(device, deletion.storage_image_view, NULL);
+    if (deletion.buffer_view)
+        vkDestroyBufferView(device, deletion.buffer_view, NULL);
+    if (deletion.image)
+        vkDestroyImage(device, deletion.image, NULL);
+    if (deletion.buffer)
+        vkDestroyBuffer(device, deletion.buffer, NULL);
+    if (deletion.memory)
+        vkFreeMemory(device, deletion.memory, NULL);
+    if (deletion.sampler)
+        vkDestroySampler(device, deletion.sampler, NULL);
+    if (deletion.pipeline)
+        vkDestroyPipeline(device, deletion.pipeline, NULL);
+    if (deletion.pipeline_layout)
+        vkDestroyPipelineLayout(device, deletion.pipeline_layout, NULL);
+    // descriptor sets free is implicit when destroying the descriptor pool
+    if (deletion.descriptor_pool)
+        vkDestroyDescriptorPool(device, deletion.descriptor_pool, NULL);
+    if (deletion.descriptor_set_layout)
+        vkDestroyDescriptorSetLayout(device, deletion.descriptor_set_layout, NULL);
+    if (deletion.shader_module)
+        vkDestroyShaderModule(device, deletion.shader_module, NULL);
+}
+
+/*
+ * Advances completed_serial up to the oldest submission whose fence is not signaled yet.
+ */
+static void vulkan_Device_poll(vulkan_Device *py_device)
+{
+    if (py_device->completed_serial >= py_device->submitted_serial)
+    {
+        return;
+    }
+
+    uint64_t completed_serial = py_device->submitted_serial;
+    if (py_device->submissions)
+    {
+        for (const vulkan_Submission &submission : *py_device->submissions)
+        {
+            if (submission.serial > py_device->completed_serial && submission.serial <= completed_serial &&
+                vkGetFenceStatus(py_device->device, submission.fence) != VK_SUCCESS)
+            {
+                completed_serial = submission.serial - 1;
+            }
+        }
+    }
+    py_device->completed_serial = completed_serial;
+}
+
+/*
+ * Destroys the deferred objects whose submission has completed.
+ */
+static void vulkan_Device_collect(vulkan_Device *py_device)
+{
+    vulkan_Device_poll(py_device);
+
+    std::vector<vulkan_DeferredDeletion> *deferred_deletions = py_device->deferred_deletions;
+    if (!deferred_deletions || deferred_deletions->empty())
+    {
+        return;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < deferred_deletions->size(); i++)
+    {
+        const vulkan_DeferredDeletion &deletion = (*deferred_deletions)[i];
+        if (deletion.serial <= py_device->completed_serial)
+        {
+            vulkan_Device_destroy(py_device, deletion);
+        }
+        else
+        {
+            (*deferred_deletions)[kept++] = deletion;
+        }
+    }
+    deferred_deletions->resize(kept);
+}
+
+/*
+ * Waits for the queue to be idle, all of the submissions are completed.
+ */
+static void vulkan_Device_wait(vulkan_Device *py_device)
+{
+    const uint64_t submitted_serial = py_device->submitted_serial;
+    Py_BEGIN_ALLOW_THREADS;
+    vkQueueWaitIdle(py_device->queue);
+    Py_END_ALLOW_THREADS;
+    py_device->completed_serial = submitted_serial;
+    vulkan_Device_collect(py_device);
+}
+
+/*
+ * Serial of the last submission that can reference the existing objects (the one of the batch being recorded).
+ */
+static uint64_t vulkan_Device_pending_serial(vulkan_Device *py_device)
+{
+    return py_device->recording_batch ? py_device->submitted_serial + 1 : py_device->submitted_serial;
+}
+
+/*
+ * Destroys the objects immediately if the GPU is idle, otherwise queues them until the last submission completes
+ * (objects cannot be tracked per submission, as the Python side does not know which ones are using them).
+ */
+static void vulkan_Device_release(vulkan_Device *py_device, vulkan_DeferredDeletion &deletion)
+{
+    vulkan_Device_poll(py_device);
+    if (!py_device->recording_batch && py_device->completed_serial >= py_device->submitted_serial)
+    {
+        vulkan_Device_destroy(py_device, deletion);
+        return;
+    }
+
+    if (!py_device->deferred_deletions)
+    {
+        py_device->deferred_deletions = new std::vector<vulkan_DeferredDeletion>();
+    }
+    deletion.serial = vulkan_Device_pending_serial(py_device);
+    py_device->deferred_deletions->push_back(deletion);
+}
+
+/*
+ * Buffers are allocated in size classes (four for each power of two) so that they can be recycled.
+ */
+static uint64_t vulkan_buffer_size_class(const uint64_t size)
+{
+    if (size <= 256)
+    {
+        return 256;
+    }
+
+    uint64_t power_of_two = 512;
+    while (power_of_two < size)
+    {
+        power_of_two <<= 1;
+    }
+    const uint64_t step = power_of_two / 8;
+    return ((size + step - 1) / step) * step;
+}
+
+static void vulkan_Device_cache_buffer(vulkan_Device *py_device, vulkan_Resource *py_resource)
+{
+    if (!py_device->buffer_cache)
+    {
+        py_device->buffer_cache = new std::unordered_map<uint64_t, std::vector<vulkan_CachedBuffer>>();
+    }
+
+    vulkan_CachedBuffer cached_buffer = {};
+    cached_buffer.serial = vulkan_Device_pending_serial(py_device);
+    cached_buffer.buffer = py_resource->buffer;
+    cached_buffer.memory = py_resource->memory;
+    cached_buffer.buffer_view = py_resource->buffer_view;
+    cached_buffer.buffer_view_range = py_resource->buffer_view ? py_resource->size : 0;
+    cached_buffer.heap_size = py_resource->heap_size;
+    cached_buffer.device_address = py_resource->device_address;
+    cached_buffer.heap_type = py_resource->heap_type;
+    cached_buffer.format = py_resource->format;
+    cached_buffer.usage = py_resource->usage;
+
+    (*py_device->buffer_cache)[py_resource->cache_size].push_back(cached_buffer);
+    py_device->buffer_cache_size += py_resource->heap_size;
+}
+
+/*
+ * Moves a cached buffer (no longer used by the GPU) matching the requested properties into the resource.
+ */
+static bool vulkan_Device_reuse_buffer(vulkan_Device *py_device, vulkan_Resource *py_resource, const int heap_type, const VkFormat format, const uint32_t usage)
+{
+    if (!py_device->buffer_cache)
+    {
+        return false;
+    }
+
+    auto bucket = py_device->buffer_cache->find(py_resource->cache_size);
+    if (bucket == py_device->buffer_cache->end())
+    {
+        return false;
+    }
+
+    std::vector<vulkan_CachedBuffer> &cached_buffers = bucket->second;
+    for (size_t i = 0; i < cached_buffers.size(); i++)
+    {
+        const vulkan_CachedBuffer &cached_buffer = cached_buffers[i];
+        if (cached_buffer.heap_type != heap_type || cached_buffer.format != format || cached_buffer.usage != usage ||
+            cached_buffer.serial > py_device->completed_serial)
+        {
+            continue;
+        }
+
+        py_resource->buffer = cached_buffer.buffer;
+        py_resource->memory = cached_buffer.memory;
+        py_resource->heap_size = cached_buffer.heap_size;
+        py_resource->device_address = cached_buffer.device_address;
+        // texel buffer views cover only the requested size
+        if (cached_buffer.buffer_view)
+        {
+            if (cached_buffer.buffer_view_range == py_resource->size)
+            {
+                py_resource->buffer_view = cached_buffer.buffer_view;
+            }
+            else
+            {
+                vkDestroyBufferView(py_device->device, cached_buffer.buffer_view, NULL);
+            }
+        }
+
+        py_device->buffer_cache_size -= cached_buffer.heap_size;
+        cached_buffers[i] = cached_buffers.back();
+        cached_buffers.pop_back();
+        return true;
+    }
+
+    return false;
+}
+
+static void vulkan_Device_release_buffer_cache(vulkan_Device *py_device)
+{
+    if (!py_device->buffer_cache)
+    {
+        return;
+    }
+
+    for (auto &bucket : *py_device->buffer_cache)
+    {
+        for (const vulkan_CachedBuffer &cached_buffer : bucket.second)
+        {
+            vulkan_DeferredDeletion deletion = {};
+            deletion.buffer = cached_buffer.buffer;
+            deletion.memory = cached_buffer.memory;
+            deletion.buffer_view = cached_buffer.buffer_view;
+            vulkan_Device_release(py_device, deletion);
+        }
+    }
+
+    py_device->buffer_cache->clear();
+    py_device->buffer_cache_size = 0;
+}
+
 static void vulkan_Resource_dealloc(vulkan_Resource *self)
 {
     if (self->py_device)
     {
-        VkDevice device = self->py_device->device;
-        if (self->image_view)
-            vkDestroyImageView(device, self->image_view, NULL);
-        if (self->buffer_view)
-            vkDestroyBufferView(device, self->buffer_view, NULL);
-        if (!self->py_heap && self->memory)
-            vkFreeMemory(device, self->memory, NULL);
-        if (self->image)
-            vkDestroyImage(self->py_device->device, self->image, NULL);
-        if (self->buffer)
-            vkDestroyBuffer(self->py_device->device, self->buffer, NULL);
+        vulkan_DeferredDeletion deletion = {};
+        deletion.has_bindless_index = self->has_bindless_index;
+        deletion.bindless_index = self->bindless_index;
+        deletion.image_view = self->image_view;
+        deletion.storage_image_view = self->storage_image_view;
+        deletion.buffer_view = self->buffer_view;
+        // views share the image/buffer and the memory of the parent resource
+        if (!self->py_parent)
+        {
+            // a texture destroyed before the next submission must not leave its initial layout transition behind
+            std::vector<VkImageMemoryBarrier> *pending_image_barriers = self->py_device->pending_image_barriers;
+            if (self->image && pending_image_barriers)
+            {
+                for (size_t i = 0; i < pending_image_barriers->size();)
+                {
+                    if ((*pending_image_barriers)[i].image == self->image)
+                    {
+                        pending_image_barriers->erase(pending_image_barriers->begin() + i);
+                    }
+                    else
+                    {
+                        i++;
+                    }
+                }
+            }
+            if (self->cache_size > 0)
+            {
+                vulkan_Device_cache_buffer(self->py_device, self);
+                deletion.buffer_view = VK_NULL_HANDLE;
+            }
+            else
+            {
+                if (!self->py_heap)
+                    deletion.memory = self->memory;
+                deletion.image = self->image;
+                deletion.buffer = self->buffer;
+            }
+        }
+        vulkan_Device_release(self->py_device, deletion);
         Py_DECREF(self->py_device);
     }
 
     Py_XDECREF(self->py_heap);
+    Py_XDECREF(self->py_parent);
+
+    if (self->tile_heaps)
+    {
+        for (vulkan_Heap *py_heap : *self->tile_heaps)
+        {
+            Py_DECREF(py_heap);
+        }
+        delete self->tile_heaps;
+    }
 
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
@@ -366,7 +861,9 @@ static void vulkan_Heap_dealloc(vulkan_Heap *self)
 {
     if (self->py_device && self->memory)
     {
-        vkFreeMemory(self->py_device->device, self->memory, NULL);
+        vulkan_DeferredDeletion deletion = {};
+        deletion.memory = self->memory;
+        vulkan_Device_release(self->py_device, deletion);
     }
 
     Py_XDECREF(self->py_device);
@@ -406,20 +903,72 @@ static PyTypeObject vulkan_Heap_Type = {
 static void vulkan_Device_dealloc(vulkan_Device *self)
 {
     Py_XDECREF(self->name);
+    Py_XDECREF(self->py_features);
+    Py_XDECREF(self->py_subgroup_operations);
 
     if (self->device)
     {
+        vulkan_Device_release_buffer_cache(self);
+        if (self->completed_serial < self->submitted_serial || (self->deferred_deletions && !self->deferred_deletions->empty()))
+        {
+            vkQueueWaitIdle(self->queue);
+            self->completed_serial = self->submitted_serial;
+            vulkan_Device_collect(self);
+        }
         if (self->command_pool)
         {
-            if (self->command_buffer)
+            if (self->submissions)
+            {
+                // the command buffer allocated with the device is one of the submissions
+                for (vulkan_Submission &submission : *self->submissions)
+                {
+                    vkFreeCommandBuffers(self->device, self->command_pool, 1, &submission.command_buffer);
+                    vkDestroyFence(self->device, submission.fence, NULL);
+                }
+            }
+            else if (self->command_buffer)
             {
                 vkFreeCommandBuffers(self->device, self->command_pool, 1, &self->command_buffer);
             }
             vkDestroyCommandPool(self->device, self->command_pool, NULL);
         }
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            if (self->sparse_semaphores[i])
+            {
+                vkDestroySemaphore(self->device, self->sparse_semaphores[i], NULL);
+            }
+        }
+        if (self->bindless_heap_pool)
+        {
+            vkDestroyDescriptorPool(self->device, self->bindless_heap_pool, NULL);
+        }
+        if (self->bindless_heap_layout)
+        {
+            vkDestroyDescriptorSetLayout(self->device, self->bindless_heap_layout, NULL);
+        }
+        if (self->constants_ring_buffer)
+        {
+            vkDestroyBuffer(self->device, self->constants_ring_buffer, NULL);
+        }
+        if (self->constants_ring_memory)
+        {
+            if (self->constants_ring_mapped)
+            {
+                vkUnmapMemory(self->device, self->constants_ring_memory);
+            }
+            vkFreeMemory(self->device, self->constants_ring_memory, NULL);
+        }
         vkDestroyDevice(self->device, NULL);
     }
 
+    delete self->bindless_heap_free;
+    delete self->pending_image_barriers;
+    delete self->submissions;
+    delete self->deferred_deletions;
+    delete self->buffer_cache;
+    delete self->mappings;
+
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -450,24 +999,13 @@ static void vulkan_Compute_dealloc(vulkan_Compute *self)
 {
     if (self->py_device)
     {
-        VkDevice device = self->py_device->device;
-        if (self->pipeline)
-            vkDestroyPipeline(device, self->pipeline, NULL);
-        if (self->pipeline_layout)
-            vkDestroyPipelineLayout(device, self->pipeline_layout, NULL);
-        if (self->descriptor_pool)
-        {
-            // descriptor sets free is implicit when destroying the descriptor
-            // pool
-            /*if (self->descriptor_set)
-                    vkFreeDescriptorSets(device, self->descriptor_pool, 1,
-               &self->descriptor_set);*/
-            vkDestroyDescriptorPool(device, self->descriptor_pool, NULL);
-        }
-        if (self->descriptor_set_layout)
-            vkDestroyDescriptorSetLayout(device, self->descriptor_set_layout, NULL);
-        if (self->shader_module)
-            vkDestroyShaderModule(device, self->shader_module, NULL);
+        vulkan_DeferredDeletion deletion = {};
+        deletion.pipeline = self->pipeline;
+        deletion.pipeline_layout = self->pipeline_layout;
+        deletion.descriptor_pool = self->descriptor_pool;
+        deletion.descriptor_set_layout = self->descriptor_set_layout;
+        deletion.shader_module = self->shader_module;
+        vulkan_Device_release(self->py_device, deletion);
 
         Py_DECREF(self->py_device);
     }
@@ -476,6 +1014,10 @@ static void vulkan_Compute_dealloc(vulkan_Compute *self)
     Py_XDECREF(self->py_srv_list);
     Py_XDECREF(self->py_uav_list);
     Py_XDECREF(self->py_samplers_list);
+    Py_XDECREF(self->py_bindings);
+
+    delete self->push_writes;
+    delete self->constants;
 
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
@@ -550,8 +1092,9 @@ static void vulkan_Sampler_dealloc(vulkan_Sampler *self)
 {
     if (self->py_device)
     {
-        if (self->sampler)
-            vkDestroySampler(self->py_device->device, self->sampler, NULL);
+        vulkan_DeferredDeletion deletion = {};
+        deletion.sampler = self->sampler;
+        vulkan_Device_release(self->py_device, deletion);
         Py_DECREF(self->py_device);
     }
 
@@ -597,6 +1140,49 @@ static PyMemberDef vulkan_Device_members[] = {
      "one"},
     {"is_discrete", T_BOOL, offsetof(vulkan_Device, is_discrete), 0,
      "returns True if this is a discrete device"},
+    {"supports_bindless", T_BOOL, offsetof(vulkan_Device, supports_bindless), 0,
+     "returns True if the device supports bindless Compute pipelines and the bindless heap (valid after the first resource is created)"},
+    {"supports_push_descriptors", T_BOOL, offsetof(vulkan_Device, supports_push_descriptors), 0,
+     "returns True if Compute pipelines can receive resources at dispatch time (valid after the first resource is created)"},
+    {"supports_buffer_device_address", T_BOOL, offsetof(vulkan_Device, supports_buffer_device_address), 0,
+     "returns True if buffers expose their GPU virtual address"},
+    {"supports_sliced_view_of_3d", T_BOOL, offsetof(vulkan_Device, supports_sliced_view_of_3d), 0,
+     "returns True if Texture3D views can restrict UAV access to a range of depth slices (valid after the first resource is created)"},
+    {"features", T_OBJECT_EX, offsetof(vulkan_Device, py_features), 0,
+     "dictionary of the optional features supported by the device"},
+    {"buffer_cache_size", T_ULONGLONG, offsetof(vulkan_Device, buffer_cache_size), READONLY,
+     "amount of memory held by the recycled Buffers"},
+    {"buffer_cache_hits", T_ULONGLONG, offsetof(vulkan_Device, buffer_cache_hits), READONLY,
+     "number of Buffers created by recycling a previous one"},
+    {"buffer_cache_misses", T_ULONGLONG, offsetof(vulkan_Device, buffer_cache_misses), READONLY,
+     "number of recyclable Buffers that required a new allocation"},
+    {"submitted_serial", T_ULONGLONG, offsetof(vulkan_Device, submitted_serial), READONLY,
+     "serial of the last queue submission"},
+    {"completed_serial", T_ULONGLONG, offsetof(vulkan_Device, completed_serial), READONLY,
+     "serial of the last submission known to be completed (updated by collect(), wait() and new submissions)"},
+    {"subgroup_size", T_UINT, offsetof(vulkan_Device, subgroup_size), 0, "device default subgroup (wave) size"},
+    {"min_subgroup_size", T_UINT, offsetof(vulkan_Device, min_subgroup_size), 0, "device minimum subgroup (wave) size"},
+    {"max_subgroup_size", T_UINT, offsetof(vulkan_Device, max_subgroup_size), 0, "device maximum subgroup (wave) size"},
+    {"subgroup_operations", T_OBJECT_EX, offsetof(vulkan_Device, py_subgroup_operations), 0,
+     "tuple of the subgroup operations supported in compute shaders"},
+    {"supports_subgroup_size_control", T_BOOL, offsetof(vulkan_Device, supports_subgroup_size_control), 0,
+     "returns True if Compute pipelines can require a specific subgroup size"},
+    {"max_compute_shared_memory_size", T_UINT, offsetof(vulkan_Device, max_compute_shared_memory_size), 0,
+     "maximum amount of groupshared memory (in bytes)"},
+    {"max_compute_work_group_invocations", T_UINT, offsetof(vulkan_Device, max_compute_work_group_invocations), 0,
+     "maximum number of threads in a thread group"},
+    {"max_compute_work_group_count_x", T_UINT, offsetof(vulkan_Device, max_compute_work_group_count), 0,
+     "maximum number of thread groups on the x axis"},
+    {"max_compute_work_group_count_y", T_UINT, offsetof(vulkan_Device, max_compute_work_group_count) + sizeof(uint32_t), 0,
+     "maximum number of thread groups on the y axis"},
+    {"max_compute_work_group_count_z", T_UINT, offsetof(vulkan_Device, max_compute_work_group_count) + sizeof(uint32_t) * 2, 0,
+     "maximum number of thread groups on the z axis"},
+    {"max_compute_work_group_size_x", T_UINT, offsetof(vulkan_Device, max_compute_work_group_size), 0,
+     "maximum thread group size on the x axis"},
+    {"max_compute_work_group_size_y", T_UINT, offsetof(vulkan_Device, max_compute_work_group_size) + sizeof(uint32_t), 0,
+     "maximum thread group size on the y axis"},
+    {"max_compute_work_group_size_z", T_UINT, offsetof(vulkan_Device, max_compute_work_group_size) + sizeof(uint32_t) * 2, 0,
+     "maximum thread group size on the z axis"},
     {NULL} /* Sentinel */
 };
 
@@ -762,26 +1348,316 @@ static PyObject *vulkan_instance_check()
     Py_RETURN_NONE;
 }
 
-static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
+/*
+ * Optional device features negotiated at device creation.
+ * Core features are enabled by default (unless disabled), extension features only when requested.
+ */
+enum vulkan_Feature
 {
-    if (self->device)
-    {
-        return self;
-    }
+    VULKAN_FEATURE_ROBUST_BUFFER_ACCESS,
+    VULKAN_FEATURE_SHADER_FLOAT64,
+    VULKAN_FEATURE_SHADER_INT64,
+    VULKAN_FEATURE_SHADER_INT16,
+    VULKAN_FEATURE_SHADER_FLOAT16,
+    VULKAN_FEATURE_SHADER_INT8,
+    VULKAN_FEATURE_STORAGE_BUFFER_16BIT_ACCESS,
+    VULKAN_FEATURE_STORAGE_BUFFER_8BIT_ACCESS,
+    VULKAN_FEATURE_SHADER_BUFFER_FLOAT32_ATOMIC_ADD,
+    VULKAN_FEATURE_MAX
+};
 
-    vkGetPhysicalDeviceFeatures(self->physical_device, &self->features);
+#define VULKAN_FEATURE_BIT(x) (1ULL << VULKAN_FEATURE_##x)
+#define VULKAN_FEATURES_CORE (VULKAN_FEATURE_BIT(ROBUST_BUFFER_ACCESS) | VULKAN_FEATURE_BIT(SHADER_FLOAT64) | VULKAN_FEATURE_BIT(SHADER_INT64) | VULKAN_FEATURE_BIT(SHADER_INT16))
+
+static const char *vulkan_feature_names[VULKAN_FEATURE_MAX] = {
+    "robust_buffer_access",
+    "shader_float64",
+    "shader_int64",
+    "shader_int16",
+    "shader_float16",
+    "shader_int8",
+    "storage_buffer_16bit_access",
+    "storage_buffer_8bit_access",
+    "shader_buffer_float32_atomic_add",
+};
 
-    std::vector<const char *> extensions;
-    uint32_t extensions_count;
-    vkEnumerateDeviceExtensionProperties(self->physical_device, NULL, &extensions_count, NULL);
-    std::vector<VkExtensionProperties> available_extensions(extensions_count);
-    vkEnumerateDeviceExtensionProperties(self->physical_device, NULL, &extensions_count, available_extensions.data());
+static const char *vulkan_feature_extensions[VULKAN_FEATURE_MAX] = {
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    "VK_KHR_shader_float16_int8",
+    "VK_KHR_shader_float16_int8",
+    "VK_KHR_16bit_storage",
+    "VK_KHR_8bit_storage",
+    "VK_EXT_shader_atomic_float",
+};
 
-    bool mutable_valve = false;
-    bool mutable_ext = false;
-    bool descriptor_indexing = false;
+typedef struct vulkan_FeaturesChain
+{
+#ifdef VK_KHR_shader_float16_int8
+    VkPhysicalDeviceShaderFloat16Int8FeaturesKHR float16_int8;
+#endif
+#ifdef VK_KHR_16bit_storage
+    VkPhysicalDevice16BitStorageFeatures storage_16bit;
+#endif
+#ifdef VK_KHR_8bit_storage
+    VkPhysicalDevice8BitStorageFeaturesKHR storage_8bit;
+#endif
+#ifdef VK_EXT_shader_atomic_float
+    VkPhysicalDeviceShaderAtomicFloatFeaturesEXT atomic_float;
+#endif
+} vulkan_FeaturesChain;
+
+/*
+ * Appends to the pNext chain the extension structs required by the features in mask (with the related booleans set).
+ * The same chain is used for querying (vkGetPhysicalDeviceFeatures2) and for enabling (vkCreateDevice).
+ */
+static void **vulkan_FeaturesChain_build(vulkan_FeaturesChain *chain, void **next, const uint64_t mask)
+{
+    memset(chain, 0, sizeof(vulkan_FeaturesChain));
+#ifdef VK_KHR_shader_float16_int8
+    if (mask & (VULKAN_FEATURE_BIT(SHADER_FLOAT16) | VULKAN_FEATURE_BIT(SHADER_INT8)))
+    {
+        chain->float16_int8.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES_KHR;
+        chain->float16_int8.shaderFloat16 = (mask & VULKAN_FEATURE_BIT(SHADER_FLOAT16)) ? VK_TRUE : VK_FALSE;
+        chain->float16_int8.shaderInt8 = (mask & VULKAN_FEATURE_BIT(SHADER_INT8)) ? VK_TRUE : VK_FALSE;
+        *next = &chain->float16_int8;
+        next = &chain->float16_int8.pNext;
+    }
+#endif
+#ifdef VK_KHR_16bit_storage
+    if (mask & VULKAN_FEATURE_BIT(STORAGE_BUFFER_16BIT_ACCESS))
+    {
+        chain->storage_16bit.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES;
+        chain->storage_16bit.storageBuffer16BitAccess = VK_TRUE;
+        *next = &chain->storage_16bit;
+        next = &chain->storage_16bit.pNext;
+    }
+#endif
+#ifdef VK_KHR_8bit_storage
+    if (mask & VULKAN_FEATURE_BIT(STORAGE_BUFFER_8BIT_ACCESS))
+    {
+        chain->storage_8bit.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES_KHR;
+        chain->storage_8bit.storageBuffer8BitAccess = VK_TRUE;
+        *next = &chain->storage_8bit;
+        next = &chain->storage_8bit.pNext;
+    }
+#endif
+#ifdef VK_EXT_shader_atomic_float
+    if (mask & VULKAN_FEATURE_BIT(SHADER_BUFFER_FLOAT32_ATOMIC_ADD))
+    {
+        chain->atomic_float.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_ATOMIC_FLOAT_FEATURES_EXT;
+        chain->atomic_float.shaderBufferFloat32AtomicAdd = VK_TRUE;
+        *next = &chain->atomic_float;
+        next = &chain->atomic_float.pNext;
+    }
+#endif
+    return next;
+}
+
+static uint64_t vulkan_get_supported_features(VkPhysicalDevice physical_device)
+{
+    uint32_t extensions_count;
+    vkEnumerateDeviceExtensionProperties(physical_device, NULL, &extensions_count, NULL);
+    std::vector<VkExtensionProperties> available_extensions(extensions_count);
+    vkEnumerateDeviceExtensionProperties(physical_device, NULL, &extensions_count, available_extensions.data());
+
+    uint64_t available_mask = 0;
+    for (uint32_t i = 0; i < VULKAN_FEATURE_MAX; i++)
+    {
+        if (!vulkan_feature_extensions[i])
+            continue;
+        for (VkExtensionProperties &extension_prop : available_extensions)
+        {
+            if (!strcmp(extension_prop.extensionName, vulkan_feature_extensions[i]))
+            {
+                available_mask |= 1ULL << i;
+                break;
+            }
+        }
+    }
+
+    vulkan_FeaturesChain chain;
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    vulkan_FeaturesChain_build(&chain, &features2.pNext, available_mask);
+    vkGetPhysicalDeviceFeatures2(physical_device, &features2);
+
+    uint64_t mask = 0;
+    if (features2.features.robustBufferAccess)
+        mask |= VULKAN_FEATURE_BIT(ROBUST_BUFFER_ACCESS);
+    if (features2.features.shaderFloat64)
+        mask |= VULKAN_FEATURE_BIT(SHADER_FLOAT64);
+    if (features2.features.shaderInt64)
+        mask |= VULKAN_FEATURE_BIT(SHADER_INT64);
+    if (features2.features.shaderInt16)
+        mask |= VULKAN_FEATURE_BIT(SHADER_INT16);
+#ifdef VK_KHR_shader_float16_int8
+    if (chain.float16_int8.shaderFloat16)
+        mask |= VULKAN_FEATURE_BIT(SHADER_FLOAT16);
+    if (chain.float16_int8.shaderInt8)
+        mask |= VULKAN_FEATURE_BIT(SHADER_INT8);
+#endif
+#ifdef VK_KHR_16bit_storage
+    if (chain.storage_16bit.storageBuffer16BitAccess)
+        mask |= VULKAN_FEATURE_BIT(STORAGE_BUFFER_16BIT_ACCESS);
+#endif
+#ifdef VK_KHR_8bit_storage
+    if (chain.storage_8bit.storageBuffer8BitAccess)
+        mask |= VULKAN_FEATURE_BIT(STORAGE_BUFFER_8BIT_ACCESS);
+#endif
+#ifdef VK_EXT_shader_atomic_float
+    if (chain.atomic_float.shaderBufferFloat32AtomicAdd)
+        mask |= VULKAN_FEATURE_BIT(SHADER_BUFFER_FLOAT32_ATOMIC_ADD);
+#endif
+    // extension features are not reported as supported if the extension is missing
+    return mask & (VULKAN_FEATURES_CORE | available_mask);
+}
+
+static bool vulkan_has_device_extension(VkPhysicalDevice physical_device, const char *name)
+{
+    uint32_t extensions_count;
+    vkEnumerateDeviceExtensionProperties(physical_device, NULL, &extensions_count, NULL);
+    std::vector<VkExtensionProperties> available_extensions(extensions_count);
+    vkEnumerateDeviceExtensionProperties(physical_device, NULL, &extensions_count, available_extensions.data());
+
+    for (VkExtensionProperties &extension_prop : available_extensions)
+    {
+        if (!strcmp(extension_prop.extensionName, name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Fills the subgroup (wave) properties and the compute limits of the device.
+ */
+static bool vulkan_Device_get_compute_properties(vulkan_Device *py_device, const VkPhysicalDeviceLimits &limits)
+{
+    py_device->max_compute_shared_memory_size = limits.maxComputeSharedMemorySize;
+    py_device->max_compute_work_group_invocations = limits.maxComputeWorkGroupInvocations;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        py_device->max_compute_work_group_count[i] = limits.maxComputeWorkGroupCount[i];
+        py_device->max_compute_work_group_size[i] = limits.maxComputeWorkGroupSize[i];
+    }
+
+    VkPhysicalDeviceSubgroupProperties subgroup_properties = {};
+    subgroup_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 properties2 = {};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &subgroup_properties;
+
+#ifdef VK_EXT_subgroup_size_control
+    const bool subgroup_size_control = vulkan_has_device_extension(py_device->physical_device, "VK_EXT_subgroup_size_control");
+    VkPhysicalDeviceSubgroupSizeControlPropertiesEXT subgroup_size_control_properties = {};
+    subgroup_size_control_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_PROPERTIES_EXT;
+    if (subgroup_size_control)
+    {
+        subgroup_properties.pNext = &subgroup_size_control_properties;
+    }
+#endif
+
+    vkGetPhysicalDeviceProperties2(py_device->physical_device, &properties2);
 
-#if VK_EXT_mutable_descriptor_type || VK_VALVE_mutable_descriptor_type || VK_EXT_descriptor_indexing || __APPLE__
+    py_device->subgroup_size = subgroup_properties.subgroupSize;
+    py_device->min_subgroup_size = subgroup_properties.subgroupSize;
+    py_device->max_subgroup_size = subgroup_properties.subgroupSize;
+
+#ifdef VK_EXT_subgroup_size_control
+    if (subgroup_size_control)
+    {
+        VkPhysicalDeviceSubgroupSizeControlFeaturesEXT subgroup_size_control_features = {};
+        subgroup_size_control_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2 = {};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &subgroup_size_control_features;
+        vkGetPhysicalDeviceFeatures2(py_device->physical_device, &features2);
+
+        if (subgroup_size_control_features.subgroupSizeControl && (subgroup_size_control_properties.requiredSubgroupSizeStages & VK_SHADER_STAGE_COMPUTE_BIT))
+        {
+            py_device->supports_subgroup_size_control = true;
+            py_device->min_subgroup_size = subgroup_size_control_properties.minSubgroupSize;
+            py_device->max_subgroup_size = subgroup_size_control_properties.maxSubgroupSize;
+        }
+    }
+#endif
+
+    const std::pair<VkSubgroupFeatureFlagBits, const char *> operations[] = {
+        {VK_SUBGROUP_FEATURE_BASIC_BIT, "basic"},
+        {VK_SUBGROUP_FEATURE_VOTE_BIT, "vote"},
+        {VK_SUBGROUP_FEATURE_ARITHMETIC_BIT, "arithmetic"},
+        {VK_SUBGROUP_FEATURE_BALLOT_BIT, "ballot"},
+        {VK_SUBGROUP_FEATURE_SHUFFLE_BIT, "shuffle"},
+        {VK_SUBGROUP_FEATURE_SHUFFLE_RELATIVE_BIT, "shuffle_relative"},
+        {VK_SUBGROUP_FEATURE_CLUSTERED_BIT, "clustered"},
+        {VK_SUBGROUP_FEATURE_QUAD_BIT, "quad"},
+    };
+
+    PyObject *py_operations = PyList_New(0);
+    if (!py_operations)
+    {
+        return false;
+    }
+
+    if (subgroup_properties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT)
+    {
+        for (const std::pair<VkSubgroupFeatureFlagBits, const char *> &operation : operations)
+        {
+            if (subgroup_properties.supportedOperations & operation.first)
+            {
+                PyObject *py_name = PyUnicode_FromString(operation.second);
+                if (!py_name || PyList_Append(py_operations, py_name) < 0)
+                {
+                    Py_XDECREF(py_name);
+                    Py_DECREF(py_operations);
+                    return false;
+                }
+                Py_DECREF(py_name);
+            }
+        }
+    }
+    py_device->py_subgroup_operations = PyList_AsTuple(py_operations);
+    Py_DECREF(py_operations);
+    return py_device->py_subgroup_operations != NULL;
+}
+
+static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
+{
+    if (self->device)
+    {
+        return self;
+    }
+
+    vkGetPhysicalDeviceFeatures(self->physical_device, &self->features);
+
+    if (self->disabled_features & VULKAN_FEATURE_BIT(ROBUST_BUFFER_ACCESS))
+        self->features.robustBufferAccess = VK_FALSE;
+    if (self->disabled_features & VULKAN_FEATURE_BIT(SHADER_FLOAT64))
+        self->features.shaderFloat64 = VK_FALSE;
+    if (self->disabled_features & VULKAN_FEATURE_BIT(SHADER_INT64))
+        self->features.shaderInt64 = VK_FALSE;
+    if (self->disabled_features & VULKAN_FEATURE_BIT(SHADER_INT16))
+        self->features.shaderInt16 = VK_FALSE;
+
+    std::vector<const char *> extensions;
+    uint32_t extensions_count;
+    vkEnumerateDeviceExtensionProperties(self->physical_device, NULL, &extensions_count, NULL);
+    std::vector<VkExtensionProperties> available_extensions(extensions_count);
+    vkEnumerateDeviceExtensionProperties(self->physical_device, NULL, &extensions_count, available_extensions.data());
+
+    bool mutable_valve = false;
+    bool mutable_ext = false;
+    bool descriptor_indexing = false;
+    bool buffer_device_address = false;
+    bool push_descriptor = false;
+    bool sliced_view_of_3d = false;
+
+#if VK_EXT_mutable_descriptor_type || VK_VALVE_mutable_descriptor_type || VK_EXT_descriptor_indexing || VK_KHR_buffer_device_address || VK_KHR_push_descriptor || VK_EXT_image_sliced_view_of_3d || __APPLE__
     for (VkExtensionProperties &extension_prop : available_extensions)
     {
 #ifdef VK_EXT_mutable_descriptor_type
@@ -811,6 +1687,33 @@ static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
         }
 #endif
 
+#ifdef VK_KHR_push_descriptor
+        if (!strcmp(extension_prop.extensionName, "VK_KHR_push_descriptor"))
+        {
+            extensions.push_back("VK_KHR_push_descriptor");
+            push_descriptor = true;
+            continue;
+        }
+#endif
+
+#ifdef VK_KHR_buffer_device_address
+        if (!strcmp(extension_prop.extensionName, "VK_KHR_buffer_device_address"))
+        {
+            extensions.push_back("VK_KHR_buffer_device_address");
+            buffer_device_address = true;
+            continue;
+        }
+#endif
+
+#ifdef VK_EXT_image_sliced_view_of_3d
+        if (!strcmp(extension_prop.extensionName, "VK_EXT_image_sliced_view_of_3d"))
+        {
+            extensions.push_back("VK_EXT_image_sliced_view_of_3d");
+            sliced_view_of_3d = true;
+            continue;
+        }
+#endif
+
 #ifdef __APPLE__
         if (!strcmp(extension_prop.extensionName, "VK_KHR_portability_subset"))
         {
@@ -821,6 +1724,33 @@ static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
     }
 #endif
 
+    const uint64_t extension_features = self->requested_features & ~VULKAN_FEATURES_CORE;
+    for (uint32_t i = 0; i < VULKAN_FEATURE_MAX; i++)
+    {
+        if (!(extension_features & (1ULL << i)))
+            continue;
+        bool already_enabled = false;
+        for (const char *extension : extensions)
+        {
+            if (!strcmp(extension, vulkan_feature_extensions[i]))
+            {
+                already_enabled = true;
+                break;
+            }
+        }
+        if (!already_enabled)
+        {
+            extensions.push_back(vulkan_feature_extensions[i]);
+        }
+    }
+
+#ifdef VK_EXT_subgroup_size_control
+    if (self->supports_subgroup_size_control)
+    {
+        extensions.push_back("VK_EXT_subgroup_size_control");
+    }
+#endif
+
     std::vector<const char *> layers;
     uint32_t layers_count;
     vkEnumerateDeviceLayerProperties(self->physical_device, &layers_count, NULL);
@@ -839,6 +1769,48 @@ static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
 
     self->supports_sparse = self->features.sparseBinding;
 
+    self->supports_push_descriptors = false;
+#ifdef VK_KHR_push_descriptor
+    if (push_descriptor)
+    {
+        VkPhysicalDevicePushDescriptorPropertiesKHR push_descriptor_properties = {};
+        push_descriptor_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+        VkPhysicalDeviceProperties2 properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &push_descriptor_properties;
+        vkGetPhysicalDeviceProperties2(self->physical_device, &properties2);
+        self->max_push_descriptors = push_descriptor_properties.maxPushDescriptors;
+    }
+#endif
+
+    self->supports_buffer_device_address = false;
+#ifdef VK_KHR_buffer_device_address
+    if (buffer_device_address)
+    {
+        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR buffer_device_address_features = {};
+        buffer_device_address_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+        VkPhysicalDeviceFeatures2 features2 = {};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &buffer_device_address_features;
+        vkGetPhysicalDeviceFeatures2(self->physical_device, &features2);
+        self->supports_buffer_device_address = buffer_device_address_features.bufferDeviceAddress == VK_TRUE;
+    }
+#endif
+
+    self->supports_sliced_view_of_3d = false;
+#ifdef VK_EXT_image_sliced_view_of_3d
+    if (sliced_view_of_3d)
+    {
+        VkPhysicalDeviceImageSlicedViewOf3DFeaturesEXT sliced_view_of_3d_features = {};
+        sliced_view_of_3d_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_SLICED_VIEW_OF_3D_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2 = {};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &sliced_view_of_3d_features;
+        vkGetPhysicalDeviceFeatures2(self->physical_device, &features2);
+        self->supports_sliced_view_of_3d = sliced_view_of_3d_features.imageSlicedViewOf3D == VK_TRUE;
+    }
+#endif
+
     uint32_t num_queue_families = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(self->physical_device, &num_queue_families, nullptr);
 
@@ -873,78 +1845,101 @@ static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
             create_info.ppEnabledExtensionNames = extensions.data();
             create_info.enabledLayerCount = (uint32_t)layers.size();
             create_info.ppEnabledLayerNames = layers.data();
-#ifndef VK_EXT_descriptor_indexing
-            if (!self->supports_bindless || (!mutable_ext && !mutable_valve))
-            {
-                create_info.pEnabledFeatures = &self->features;
-            }
-#endif
+            /*
+             * all of the optional features are enabled with a single VkPhysicalDeviceFeatures2 chain
+             */
+            VkPhysicalDeviceFeatures2 device_features = {};
+            device_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            device_features.features = self->features;
+            void **features_chain = &device_features.pNext;
 
-            VkResult result = (VkResult)-13 /* VK_ERROR_UNKNOWN*/;
+#ifdef VK_EXT_descriptor_indexing
+            VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features = {};
+            descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+            descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+            descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingUniformBufferUpdateAfterBind = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingUniformTexelBufferUpdateAfterBind = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingStorageTexelBufferUpdateAfterBind = VK_TRUE;
+#endif
+#ifdef VK_EXT_mutable_descriptor_type
+            VkPhysicalDeviceMutableDescriptorTypeFeaturesEXT mutable_ext_features = {};
+            mutable_ext_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_EXT;
+            mutable_ext_features.mutableDescriptorType = VK_TRUE;
+#endif
+#ifdef VK_VALVE_mutable_descriptor_type
+            VkPhysicalDeviceMutableDescriptorTypeFeaturesVALVE mutable_valve_features = {};
+            mutable_valve_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_VALVE;
+            mutable_valve_features.mutableDescriptorType = VK_TRUE;
+#endif
 
             if (self->supports_bindless)
             {
+#ifdef VK_EXT_descriptor_indexing
+                *features_chain = &descriptor_indexing_features;
+                features_chain = &descriptor_indexing_features.pNext;
+#endif
                 if (mutable_ext)
                 {
-#if VK_EXT_descriptor_indexing
 #ifdef VK_EXT_mutable_descriptor_type
-                    VkPhysicalDeviceMutableDescriptorTypeFeaturesEXT mutable_descriptor_type_features = {};
-                    mutable_descriptor_type_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_EXT;
-                    mutable_descriptor_type_features.mutableDescriptorType = VK_TRUE;
-                    VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features = {};
-                    descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
-                    descriptor_indexing_features.pNext = &mutable_descriptor_type_features;
-                    descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
-                    descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingUniformBufferUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingUniformTexelBufferUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingStorageTexelBufferUpdateAfterBind = VK_TRUE;
-
-                    VkPhysicalDeviceFeatures2 deviceFeatures = {};
-                    deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-                    deviceFeatures.pNext = &descriptor_indexing_features;
-                    deviceFeatures.features = self->features;
-
-                    create_info.pNext = &deviceFeatures;
-                    result = vkCreateDevice(self->physical_device, &create_info, nullptr, &device);
+                    *features_chain = &mutable_ext_features;
+                    features_chain = &mutable_ext_features.pNext;
 #endif
                 }
                 else if (mutable_valve)
                 {
 #ifdef VK_VALVE_mutable_descriptor_type
-                    VkPhysicalDeviceMutableDescriptorTypeFeaturesVALVE mutable_descriptor_type_features = {};
-                    mutable_descriptor_type_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_VALVE;
-                    mutable_descriptor_type_features.mutableDescriptorType = VK_TRUE;
-                    VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features = {};
-                    descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
-                    descriptor_indexing_features.pNext = &mutable_descriptor_type_features;
-                    descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
-                    descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingUniformBufferUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingUniformTexelBufferUpdateAfterBind = VK_TRUE;
-                    descriptor_indexing_features.descriptorBindingStorageTexelBufferUpdateAfterBind = VK_TRUE;
-
-                    VkPhysicalDeviceFeatures2 deviceFeatures = {};
-                    deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-                    deviceFeatures.pNext = &descriptor_indexing_features;
-                    deviceFeatures.features = self->features;
-
-                    create_info.pNext = &deviceFeatures;
-                    result = vkCreateDevice(self->physical_device, &create_info, nullptr, &device);
-#endif
+                    *features_chain = &mutable_valve_features;
+                    features_chain = &mutable_valve_features.pNext;
 #endif
                 }
             }
-            else
+
+#ifdef VK_KHR_buffer_device_address
+            VkPhysicalDeviceBufferDeviceAddressFeaturesKHR buffer_device_address_features = {};
+            buffer_device_address_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES_KHR;
+            buffer_device_address_features.bufferDeviceAddress = VK_TRUE;
+
+            if (self->supports_buffer_device_address)
+            {
+                *features_chain = &buffer_device_address_features;
+                features_chain = &buffer_device_address_features.pNext;
+            }
+#endif
+
+#ifdef VK_EXT_image_sliced_view_of_3d
+            VkPhysicalDeviceImageSlicedViewOf3DFeaturesEXT sliced_view_of_3d_features = {};
+            sliced_view_of_3d_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_SLICED_VIEW_OF_3D_FEATURES_EXT;
+            sliced_view_of_3d_features.imageSlicedViewOf3D = VK_TRUE;
+
+            if (self->supports_sliced_view_of_3d)
             {
-                result = vkCreateDevice(self->physical_device, &create_info, nullptr, &device);
+                *features_chain = &sliced_view_of_3d_features;
+                features_chain = &sliced_view_of_3d_features.pNext;
             }
+#endif
+
+#ifdef VK_EXT_subgroup_size_control
+            VkPhysicalDeviceSubgroupSizeControlFeaturesEXT subgroup_size_control_features = {};
+            subgroup_size_control_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_SIZE_CONTROL_FEATURES_EXT;
+            subgroup_size_control_features.subgroupSizeControl = VK_TRUE;
+
+            if (self->supports_subgroup_size_control)
+            {
+                *features_chain = &subgroup_size_control_features;
+                features_chain = &subgroup_size_control_features.pNext;
+            }
+#endif
+
+            vulkan_FeaturesChain requested_features_chain;
+            features_chain = vulkan_FeaturesChain_build(&requested_features_chain, features_chain, extension_features);
+
+            create_info.pNext = &device_features;
+
+            VkResult result = vkCreateDevice(self->physical_device, &create_info, nullptr, &device);
 
             if (result != VK_SUCCESS)
             {
@@ -984,6 +1979,26 @@ static vulkan_Device *vulkan_Device_get_device(vulkan_Device *self)
                 return NULL;
             }
 
+#ifdef VK_KHR_buffer_device_address
+            if (self->supports_buffer_device_address)
+            {
+                self->get_buffer_device_address = (PFN_vkGetBufferDeviceAddressKHR)vkGetDeviceProcAddr(device, "vkGetBufferDeviceAddressKHR");
+                if (!self->get_buffer_device_address)
+                {
+                    self->get_buffer_device_address = (PFN_vkGetBufferDeviceAddressKHR)vkGetDeviceProcAddr(device, "vkGetBufferDeviceAddress");
+                }
+                self->supports_buffer_device_address = self->get_buffer_device_address != nullptr;
+            }
+#endif
+
+#ifdef VK_KHR_push_descriptor
+            if (push_descriptor)
+            {
+                self->cmd_push_descriptor_set = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(device, "vkCmdPushDescriptorSetKHR");
+                self->supports_push_descriptors = self->cmd_push_descriptor_set != nullptr;
+            }
+#endif
+
             self->device = device;
             self->queue = queue;
             self->queue_family_index = queue_family_index;
@@ -1057,6 +2072,17 @@ static PyObject *vulkan_Device_create_heap(vulkan_Device *self, PyObject *args)
     allocate_info.allocationSize = size;
     allocate_info.memoryTypeIndex = vulkan_get_memory_type_index_by_flag(&self->mem_props, mem_flag);
 
+    // buffers placed in the heap could require a device address
+#ifdef VK_KHR_buffer_device_address
+    VkMemoryAllocateFlagsInfo allocate_flags_info = {};
+    if (py_device->supports_buffer_device_address)
+    {
+        allocate_flags_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        allocate_flags_info.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+        allocate_info.pNext = &allocate_flags_info;
+    }
+#endif
+
     VkResult result = vkAllocateMemory(py_device->device, &allocate_info, NULL, &py_heap->memory);
     if (result != VK_SUCCESS)
     {
@@ -1079,15 +2105,31 @@ static PyObject *vulkan_Device_create_buffer(vulkan_Device *self, PyObject *args
     PyObject *py_heap;
     uint64_t heap_offset;
     PyObject *py_sparse;
-    if (!PyArg_ParseTuple(args, "iKIiOKO", &heap_type, &size, &stride, &format, &py_heap, &heap_offset, &py_sparse))
+    uint32_t usage = 0;
+    if (!PyArg_ParseTuple(args, "iKIiOKO|I", &heap_type, &size, &stride, &format, &py_heap, &heap_offset, &py_sparse, &usage))
         return NULL;
 
+    if (usage & ~COMPUSHADY_USAGE_ALL)
+    {
+        return PyErr_Format(Compushady_BufferError, "invalid usage: %u", usage);
+    }
+
+    if (usage == 0)
+    {
+        usage = COMPUSHADY_USAGE_ALL;
+    }
+
     if (format > 0)
     {
         if (vulkan_formats.find(format) == vulkan_formats.end())
         {
             return PyErr_Format(Compushady_BufferError, "invalid pixel format");
         }
+
+        if (!(usage & (COMPUSHADY_USAGE_READ_ONLY | COMPUSHADY_USAGE_STORAGE)))
+        {
+            return PyErr_Format(Compushady_BufferError, "formatted Buffers require USAGE_READ_ONLY or USAGE_STORAGE");
+        }
     }
 
     if (!size)
@@ -1108,7 +2150,20 @@ static PyObject *vulkan_Device_create_buffer(vulkan_Device *self, PyObject *args
     buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     buffer_create_info.size = size;
     buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    buffer_create_info.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    buffer_create_info.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    // SRVs (StructuredBuffer and ByteAddressBuffer) are storage buffers too
+    if (usage & COMPUSHADY_USAGE_READ_ONLY)
+        buffer_create_info.usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (usage & COMPUSHADY_USAGE_STORAGE)
+        buffer_create_info.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+    if (usage & COMPUSHADY_USAGE_TRANSFER)
+        buffer_create_info.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+#ifdef VK_KHR_buffer_device_address
+    if (py_device->supports_buffer_device_address)
+    {
+        buffer_create_info.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR;
+    }
+#endif
 
     if (sparse)
     {
@@ -1139,99 +2194,152 @@ static PyObject *vulkan_Device_create_buffer(vulkan_Device *self, PyObject *args
     COMPUSHADY_CLEAR(py_resource);
     py_resource->py_device = py_device;
     Py_INCREF(py_resource->py_device);
+    py_resource->usage = usage;
 
-    VkResult result = vkCreateBuffer(py_device->device, &buffer_create_info, NULL, &py_resource->buffer);
-    if (result != VK_SUCCESS)
-    {
-        Py_DECREF(py_resource);
-        return PyErr_Format(Compushady_BufferError, "unable to create vulkan Buffer");
-    }
+    // plain buffers (not sparse and not placed in a heap) are recycled by the device cache
+    const bool cacheable = !sparse && !(py_heap && py_heap != Py_None);
+    const uint64_t cache_size = cacheable ? vulkan_buffer_size_class(size) : 0;
+    const VkFormat vk_format = format > 0 ? vulkan_formats[format].first : VK_FORMAT_UNDEFINED;
 
-    VkMemoryRequirements requirements;
-    vkGetBufferMemoryRequirements(py_device->device, py_resource->buffer, &requirements);
+    py_resource->size = size;
+    py_resource->cache_size = cache_size;
+    const bool cached = cacheable && vulkan_Device_reuse_buffer(py_device, py_resource, heap_type, vk_format, usage);
+    py_resource->cache_size = 0;
 
-    if (sparse)
+    VkResult result = VK_SUCCESS;
+    if (cached)
     {
-        py_resource->tile_width = static_cast<uint32_t>(requirements.alignment);
-        py_resource->tile_height = 1;
-        py_resource->tile_depth = 1;
-        py_resource->tiles_x = static_cast<uint32_t>(ceil(static_cast<double>(requirements.size) / requirements.alignment));
-        py_resource->tiles_y = 1;
-        py_resource->tiles_z = 1;
+        py_device->buffer_cache_hits++;
         heap_offset = 0;
     }
-    else if (py_heap && py_heap != Py_None)
+    else
     {
-        int ret = PyObject_IsInstance(py_heap, (PyObject *)&vulkan_Heap_Type);
-        if (ret < 0)
+        if (cacheable)
         {
-            return NULL;
+            py_device->buffer_cache_misses++;
+            buffer_create_info.size = cache_size;
         }
-        else if (ret == 0)
+
+        result = vkCreateBuffer(py_device->device, &buffer_create_info, NULL, &py_resource->buffer);
+        if (result != VK_SUCCESS)
         {
-            return PyErr_Format(PyExc_ValueError, "Expected a Heap object");
+            Py_DECREF(py_resource);
+            return PyErr_Format(Compushady_BufferError, "unable to create vulkan Buffer");
         }
 
-        vulkan_Heap *py_vulkan_heap = (vulkan_Heap *)py_heap;
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(py_device->device, py_resource->buffer, &requirements);
+        py_resource->heap_size = requirements.size;
 
-        if (py_vulkan_heap->py_device != py_device)
+        if (sparse)
         {
-            return PyErr_Format(Compushady_BufferError, "Cannot use heap from a different device");
+            py_resource->tile_width = static_cast<uint32_t>(requirements.alignment);
+            py_resource->tile_height = 1;
+            py_resource->tile_depth = 1;
+            py_resource->tiles_x = static_cast<uint32_t>(ceil(static_cast<double>(requirements.size) / requirements.alignment));
+            py_resource->tiles_y = 1;
+            py_resource->tiles_z = 1;
+            heap_offset = 0;
         }
-
-        if (py_vulkan_heap->heap_type != heap_type)
+        else if (py_heap && py_heap != Py_None)
         {
-            return PyErr_Format(Compushady_BufferError, "Unsupported heap type");
-        }
+            int ret = PyObject_IsInstance(py_heap, (PyObject *)&vulkan_Heap_Type);
+            if (ret < 0)
+            {
+                return NULL;
+            }
+            else if (ret == 0)
+            {
+                return PyErr_Format(PyExc_ValueError, "Expected a Heap object");
+            }
 
-        if (heap_offset + requirements.size > py_vulkan_heap->size)
-        {
-            return PyErr_Format(Compushady_BufferError,
-                                "supplied heap is not big enough for the resource size: (offset %llu) %llu "
-                                "(required %llu)",
-                                heap_offset, py_vulkan_heap->size, requirements.size);
-        }
+            vulkan_Heap *py_vulkan_heap = (vulkan_Heap *)py_heap;
 
-        py_resource->memory = py_vulkan_heap->memory;
-        py_resource->py_heap = py_vulkan_heap;
-        Py_INCREF(py_resource->py_heap);
-    }
-    else
-    {
-        VkMemoryAllocateInfo allocate_info = {};
-        allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocate_info.allocationSize = requirements.size;
-        allocate_info.memoryTypeIndex = vulkan_get_memory_type_index_by_flag(&self->mem_props, mem_flag);
+            if (py_vulkan_heap->py_device != py_device)
+            {
+                return PyErr_Format(Compushady_BufferError, "Cannot use heap from a different device");
+            }
 
-        result = vkAllocateMemory(py_device->device, &allocate_info, NULL, &py_resource->memory);
-        if (result != VK_SUCCESS)
-        {
-            Py_DECREF(py_resource);
-            return PyErr_Format(Compushady_BufferError, "unable to create vulkan Buffer memory");
-        }
+            if (py_vulkan_heap->heap_type != heap_type)
+            {
+                return PyErr_Format(Compushady_BufferError, "Unsupported heap type");
+            }
 
-        heap_offset = 0;
-    }
+            if (heap_offset + requirements.size > py_vulkan_heap->size)
+            {
+                return PyErr_Format(Compushady_BufferError,
+                                    "supplied heap is not big enough for the resource size: (offset %llu) %llu "
+                                    "(required %llu)",
+                                    heap_offset, py_vulkan_heap->size, requirements.size);
+            }
 
-    if (!sparse)
-    {
-        result = vkBindBufferMemory(py_device->device, py_resource->buffer, py_resource->memory, heap_offset);
-        if (result != VK_SUCCESS)
+            py_resource->memory = py_vulkan_heap->memory;
+            py_resource->py_heap = py_vulkan_heap;
+            Py_INCREF(py_resource->py_heap);
+        }
+        else
         {
-            Py_DECREF(py_resource);
-            return PyErr_Format(Compushady_BufferError, "unable to bind vulkan Buffer memory");
+            VkMemoryAllocateInfo allocate_info = {};
+            allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocate_info.allocationSize = requirements.size;
+            allocate_info.memoryTypeIndex = vulkan_get_memory_type_index_by_flag(&self->mem_props, mem_flag);
+
+#ifdef VK_KHR_buffer_device_address
+            VkMemoryAllocateFlagsInfo allocate_flags_info = {};
+            if (py_device->supports_buffer_device_address)
+            {
+                allocate_flags_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+                allocate_flags_info.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+                allocate_info.pNext = &allocate_flags_info;
+            }
+#endif
+
+            result = vkAllocateMemory(py_device->device, &allocate_info, NULL, &py_resource->memory);
+            // the recycled Buffers could be holding the required memory: free them (waiting for the submissions
+            // still using them) and retry once
+            if (result != VK_SUCCESS && py_device->buffer_cache_size > 0)
+            {
+                vulkan_Device_release_buffer_cache(py_device);
+                if (py_device->deferred_deletions && !py_device->deferred_deletions->empty())
+                {
+                    vulkan_Device_wait(py_device);
+                }
+                result = vkAllocateMemory(py_device->device, &allocate_info, NULL, &py_resource->memory);
+            }
+            if (result != VK_SUCCESS)
+            {
+                Py_DECREF(py_resource);
+                return PyErr_Format(Compushady_BufferError, "unable to create vulkan Buffer memory");
+            }
+
+            heap_offset = 0;
+        }
+
+        if (!sparse)
+        {
+            result = vkBindBufferMemory(py_device->device, py_resource->buffer, py_resource->memory, heap_offset);
+            if (result != VK_SUCCESS)
+            {
+                Py_DECREF(py_resource);
+                return PyErr_Format(Compushady_BufferError, "unable to bind vulkan Buffer memory");
+            }
         }
     }
 
     if (format > 0)
     {
         py_resource->format = vulkan_formats[format].first;
+    }
+
+    if (format > 0 && !py_resource->buffer_view)
+    {
         VkBufferViewCreateInfo buffer_view_create_info = {};
         buffer_view_create_info.format = vulkan_formats[format].first;
         buffer_view_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO;
         buffer_view_create_info.buffer = py_resource->buffer;
 
-        buffer_view_create_info.range = VK_WHOLE_SIZE;
+        // the buffer could be bigger than requested (size classes), so limit the view to the requested elements
+        buffer_view_create_info.range = size - (size % vulkan_formats[format].second);
 
         result = vkCreateBufferView(
             py_device->device, &buffer_view_create_info, NULL, &py_resource->buffer_view);
@@ -1242,53 +2350,368 @@ static PyObject *vulkan_Device_create_buffer(vulkan_Device *self, PyObject *args
         }
     }
 
+#ifdef VK_KHR_buffer_device_address
+    if (py_device->supports_buffer_device_address && !py_resource->device_address)
+    {
+        VkBufferDeviceAddressInfoKHR buffer_device_address_info = {};
+        buffer_device_address_info.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+        buffer_device_address_info.buffer = py_resource->buffer;
+        py_resource->device_address = py_device->get_buffer_device_address(py_device->device, &buffer_device_address_info);
+    }
+#endif
+
     py_resource->size = size;
     py_resource->heap_offset = heap_offset;
     py_resource->stride = stride;
     py_resource->descriptor_buffer_info.buffer = py_resource->buffer;
     py_resource->descriptor_buffer_info.range = size;
-    py_resource->heap_size = requirements.size;
     py_resource->slices = 1;
     py_resource->heap_type = heap_type;
+    py_resource->cache_size = cache_size;
 
     return (PyObject *)py_resource;
 }
 
-static bool vulkan_texture_set_layout(
-    vulkan_Device *py_device, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, const uint32_t slices)
+/*
+ * Selects the command buffer to record: the first one whose submission has completed, a new one (with its fence)
+ * while there are less than VULKAN_MAX_SUBMISSIONS in flight, otherwise the oldest one is waited for.
+ */
+static void vulkan_Device_acquire_command_buffer(vulkan_Device *py_device)
+{
+    if (!py_device->submissions)
+    {
+        py_device->submissions = new std::vector<vulkan_Submission>();
+    }
+
+    std::vector<vulkan_Submission> &submissions = *py_device->submissions;
+
+    vulkan_Device_poll(py_device);
+
+    size_t oldest = 0;
+    for (size_t i = 0; i < submissions.size(); i++)
+    {
+        if (submissions[i].serial <= py_device->completed_serial)
+        {
+            py_device->current_submission = i;
+            py_device->command_buffer = submissions[i].command_buffer;
+            return;
+        }
+        if (submissions[i].serial < submissions[oldest].serial)
+        {
+            oldest = i;
+        }
+    }
+
+    if (submissions.size() < VULKAN_MAX_SUBMISSIONS)
+    {
+        vulkan_Submission submission = {};
+        VkFenceCreateInfo fence_create_info = {};
+        fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(py_device->device, &fence_create_info, NULL, &submission.fence) == VK_SUCCESS)
+        {
+            // the first submission reuses the command buffer allocated with the device
+            VkResult result = VK_SUCCESS;
+            if (submissions.empty())
+            {
+                submission.command_buffer = py_device->command_buffer;
+            }
+            else
+            {
+                VkCommandBufferAllocateInfo command_buffer_allocate_info = {};
+                command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                command_buffer_allocate_info.commandPool = py_device->command_pool;
+                command_buffer_allocate_info.commandBufferCount = 1;
+                result = vkAllocateCommandBuffers(py_device->device, &command_buffer_allocate_info, &submission.command_buffer);
+            }
+
+            if (result == VK_SUCCESS)
+            {
+                py_device->current_submission = submissions.size();
+                py_device->command_buffer = submission.command_buffer;
+                submissions.push_back(submission);
+                return;
+            }
+            vkDestroyFence(py_device->device, submission.fence, NULL);
+        }
+
+        // no more command buffers can be allocated, wait for the whole queue
+        if (submissions.empty())
+        {
+            Py_BEGIN_ALLOW_THREADS;
+            vkQueueWaitIdle(py_device->queue);
+            Py_END_ALLOW_THREADS;
+            py_device->completed_serial = py_device->submitted_serial;
+            return;
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    vkWaitForFences(py_device->device, 1, &submissions[oldest].fence, VK_TRUE, UINT64_MAX);
+    Py_END_ALLOW_THREADS;
+    vulkan_Device_poll(py_device);
+    py_device->current_submission = oldest;
+    py_device->command_buffer = submissions[oldest].command_buffer;
+}
+
+/*
+ * Starts recording commands. Inside a batch the command buffer is already recording, so the new commands
+ * are only ordered after the previous ones.
+ */
+static void vulkan_Device_begin(vulkan_Device *py_device)
+{
+    if (!py_device->recording_batch)
+    {
+        vulkan_Device_acquire_command_buffer(py_device);
+
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkBeginCommandBuffer(py_device->command_buffer, &begin_info);
+    }
+
+    // the writes of the submissions still in flight (or of the previous commands of the batch) must be visible to the new commands
+    if (py_device->recording_batch || py_device->completed_serial < py_device->submitted_serial)
+    {
+        VkMemoryBarrier memory_barrier = {};
+        memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memory_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        memory_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(py_device->command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &memory_barrier, 0, 0, 0, 0);
+    }
+
+    // the initial layouts of the textures created since the last submission are set with a single batch
+    if (py_device->pending_image_barriers && !py_device->pending_image_barriers->empty())
+    {
+        vkCmdPipelineBarrier(py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, 0, 0, 0,
+                             (uint32_t)py_device->pending_image_barriers->size(), py_device->pending_image_barriers->data());
+        py_device->pending_image_barriers->clear();
+    }
+}
+
+/*
+ * Returns the submission owning the acquired command buffer (with its fence reset), NULL if it has no fence.
+ */
+static vulkan_Submission *vulkan_Device_get_submission(vulkan_Device *py_device)
+{
+    if (!py_device->submissions || py_device->current_submission >= py_device->submissions->size())
+    {
+        return NULL;
+    }
+
+    vulkan_Submission *submission = &(*py_device->submissions)[py_device->current_submission];
+    if (submission->command_buffer != py_device->command_buffer)
+    {
+        return NULL;
+    }
+
+    vkResetFences(py_device->device, 1, &submission->fence);
+    return submission;
+}
+
+/*
+ * Assigns the next serial to a successful queue operation, the ones without a fence are waited for.
+ */
+static void vulkan_Device_submitted(vulkan_Device *py_device, vulkan_Submission *submission)
+{
+    py_device->submitted_serial++;
+    if (submission)
+    {
+        submission->serial = py_device->submitted_serial;
+    }
+    else
+    {
+        vulkan_Device_wait(py_device);
+    }
+}
+
+/*
+ * Ends and submits the device command buffer, signaling its fence.
+ * If sparse bindings are still in flight, the submission waits for their semaphore.
+ */
+static VkResult vulkan_Device_submit(vulkan_Device *py_device, VkSemaphore wait_semaphore, VkPipelineStageFlags wait_stage, VkSemaphore signal_semaphore)
+{
+    // the commands of a batch are submitted all together at its end
+    if (py_device->recording_batch)
+    {
+        return VK_SUCCESS;
+    }
+
+    vkEndCommandBuffer(py_device->command_buffer);
+
+    // reclaim the objects released while the previous submissions were in flight
+    vulkan_Device_collect(py_device);
+
+    VkSemaphore wait_semaphores[2];
+    VkPipelineStageFlags wait_stages[2];
+    uint32_t wait_semaphores_count = 0;
+
+    if (wait_semaphore)
+    {
+        wait_semaphores[wait_semaphores_count] = wait_semaphore;
+        wait_stages[wait_semaphores_count++] = wait_stage;
+    }
+
+    if (py_device->sparse_pending)
+    {
+        wait_semaphores[wait_semaphores_count] = py_device->sparse_semaphores[py_device->sparse_semaphore_index];
+        wait_stages[wait_semaphores_count++] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pCommandBuffers = &py_device->command_buffer;
+    submit_info.commandBufferCount = 1;
+    submit_info.pWaitSemaphores = wait_semaphores;
+    submit_info.waitSemaphoreCount = wait_semaphores_count;
+    submit_info.pWaitDstStageMask = wait_stages;
+    if (signal_semaphore)
+    {
+        submit_info.signalSemaphoreCount = 1;
+        submit_info.pSignalSemaphores = &signal_semaphore;
+    }
+
+    vulkan_Submission *submission = vulkan_Device_get_submission(py_device);
+
+    VkResult result = vkQueueSubmit(py_device->queue, 1, &submit_info, submission ? submission->fence : VK_NULL_HANDLE);
+    if (result == VK_SUCCESS)
+    {
+        py_device->sparse_pending = false;
+        vulkan_Device_submitted(py_device, submission);
+    }
+    return result;
+}
+
+static VkResult vulkan_Device_submit_and_wait(vulkan_Device *py_device)
+{
+    if (py_device->recording_batch)
+    {
+        return VK_SUCCESS;
+    }
+
+    VkResult result = vulkan_Device_submit(py_device, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+    if (result == VK_SUCCESS)
+    {
+        vulkan_Device_wait(py_device);
+    }
+    return result;
+}
+
+static bool vulkan_texture_check_usage(uint32_t *usage)
+{
+    if (*usage & ~COMPUSHADY_USAGE_ALL)
+    {
+        PyErr_Format(PyExc_ValueError, "invalid usage: %u", *usage);
+        return false;
+    }
+
+    if (*usage == 0)
+    {
+        *usage = COMPUSHADY_USAGE_ALL;
+    }
+
+    if (!(*usage & (COMPUSHADY_USAGE_READ_ONLY | COMPUSHADY_USAGE_STORAGE)))
+    {
+        PyErr_Format(PyExc_ValueError, "Textures require USAGE_READ_ONLY or USAGE_STORAGE");
+        return false;
+    }
+
+    return true;
+}
+
+// SRV-only textures live in SHADER_READ_ONLY_OPTIMAL (keeping the hardware compression), everything else in GENERAL
+static VkImageLayout vulkan_texture_get_layout(const uint32_t usage)
 {
-    VkCommandBufferBeginInfo begin_info = {};
-    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    return (usage & COMPUSHADY_USAGE_STORAGE) ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
 
+static VkImageMemoryBarrier vulkan_texture_layout_barrier(
+    VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, const uint32_t slices, const uint32_t mips)
+{
     VkImageMemoryBarrier image_memory_barrier = {};
     image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     image_memory_barrier.image = image;
     image_memory_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_memory_barrier.subresourceRange.levelCount = 1;
+    image_memory_barrier.subresourceRange.levelCount = mips;
     image_memory_barrier.subresourceRange.layerCount = slices;
-    image_memory_barrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    image_memory_barrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
     image_memory_barrier.oldLayout = old_layout;
     image_memory_barrier.newLayout = new_layout;
+    image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    return image_memory_barrier;
+}
+
+/*
+ * Queues the layout transition of a new texture, it will be recorded at the beginning of the next submission
+ * (so creating lots of textures does not require a GPU round trip for each of them).
+ */
+static void vulkan_texture_defer_layout(
+    vulkan_Device *py_device, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, const uint32_t slices, const uint32_t mips)
+{
+    if (!py_device->pending_image_barriers)
+    {
+        py_device->pending_image_barriers = new std::vector<VkImageMemoryBarrier>();
+    }
+    py_device->pending_image_barriers->push_back(vulkan_texture_layout_barrier(image, old_layout, new_layout, slices, mips));
+}
+
+static bool vulkan_texture_set_layout(
+    vulkan_Device *py_device, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, const uint32_t slices, const uint32_t mips)
+{
+    VkImageMemoryBarrier image_memory_barrier = vulkan_texture_layout_barrier(image, old_layout, new_layout, slices, mips);
 
-    vkBeginCommandBuffer(py_device->command_buffer, &begin_info);
+    vulkan_Device_begin(py_device);
     vkCmdPipelineBarrier(py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
-    vkEndCommandBuffer(py_device->command_buffer);
 
-    VkSubmitInfo submit_info = {};
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.pCommandBuffers = &py_device->command_buffer;
-    submit_info.commandBufferCount = 1;
+    return vulkan_Device_submit_and_wait(py_device) == VK_SUCCESS;
+}
 
-    VkResult result = vkQueueSubmit(py_device->queue, 1, &submit_info, VK_NULL_HANDLE);
-    if (result == VK_SUCCESS)
+static VkResult vulkan_texture_create_view(VkDevice device, VkImage image, VkImageViewType view_type, VkFormat format,
+                                           const uint32_t base_mip, const uint32_t mips, const uint32_t base_slice, const uint32_t slices, VkImageView *image_view)
+{
+    VkImageViewCreateInfo image_view_create_info = {};
+    image_view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    image_view_create_info.image = image;
+    image_view_create_info.viewType = view_type;
+    image_view_create_info.format = format;
+    image_view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_view_create_info.subresourceRange.baseMipLevel = base_mip;
+    image_view_create_info.subresourceRange.levelCount = mips;
+    image_view_create_info.subresourceRange.baseArrayLayer = base_slice;
+    image_view_create_info.subresourceRange.layerCount = slices;
+
+    return vkCreateImageView(device, &image_view_create_info, NULL, image_view);
+}
+
+static bool vulkan_texture_create_views(vulkan_Resource *py_resource, VkImageViewType view_type, VkFormat format, const uint32_t slices, const uint32_t mips)
+{
+    // SRVs can access the whole mip chain, while storage images (UAVs) can only address a single mip
+    VkResult result = vulkan_texture_create_view(py_resource->py_device->device, py_resource->image, view_type, format, 0, mips, 0, slices, &py_resource->image_view);
+    if (result != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    py_resource->descriptor_image_info.imageView = py_resource->image_view;
+    py_resource->descriptor_image_info.imageLayout = py_resource->layout;
+    py_resource->descriptor_storage_image_info = py_resource->descriptor_image_info;
+
+    if (mips > 1)
     {
-        Py_BEGIN_ALLOW_THREADS;
-        vkQueueWaitIdle(py_device->queue);
-        Py_END_ALLOW_THREADS;
+        result = vulkan_texture_create_view(py_resource->py_device->device, py_resource->image, view_type, format, 0, 1, 0, slices, &py_resource->storage_image_view);
+        if (result != VK_SUCCESS)
+        {
+            return false;
+        }
+        py_resource->descriptor_storage_image_info.imageView = py_resource->storage_image_view;
     }
 
-    return result == VK_SUCCESS;
+    py_resource->image_view_type = view_type;
+    py_resource->format = format;
+    py_resource->mips = mips;
+    return true;
 }
 
 static PyObject *vulkan_Device_create_texture2d(vulkan_Device *self, PyObject *args)
@@ -1300,7 +2723,12 @@ static PyObject *vulkan_Device_create_texture2d(vulkan_Device *self, PyObject *a
     uint64_t heap_offset;
     uint32_t slices;
     PyObject *py_sparse;
-    if (!PyArg_ParseTuple(args, "IIiOKIO", &width, &height, &format, &py_heap, &heap_offset, &slices, &py_sparse))
+    uint32_t mips = 1;
+    uint32_t usage = 0;
+    if (!PyArg_ParseTuple(args, "IIiOKIO|II", &width, &height, &format, &py_heap, &heap_offset, &slices, &py_sparse, &mips, &usage))
+        return NULL;
+
+    if (!vulkan_texture_check_usage(&usage))
         return NULL;
 
     if (width == 0)
@@ -1323,6 +2751,11 @@ static PyObject *vulkan_Device_create_texture2d(vulkan_Device *self, PyObject *a
         return PyErr_Format(PyExc_ValueError, "invalid pixel format");
     }
 
+    if (mips == 0 || mips > compushady_get_max_mips(width, height, 1))
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid number of mips: %u (max %u)", mips, compushady_get_max_mips(width, height, 1));
+    }
+
     const bool sparse = py_sparse && PyObject_IsTrue(py_sparse);
 
     vulkan_Device *py_device = vulkan_Device_get_device(self);
@@ -1334,6 +2767,11 @@ static PyObject *vulkan_Device_create_texture2d(vulkan_Device *self, PyObject *a
         return PyErr_Format(PyExc_ValueError, "sparse resources are not supported");
     }
 
+    if (sparse && mips > 1)
+    {
+        return PyErr_Format(PyExc_ValueError, "sparse resources with mips are not supported");
+    }
+
     vulkan_Resource *py_resource = (vulkan_Resource *)PyObject_New(vulkan_Resource, &vulkan_Resource_Type);
     if (!py_resource)
     {
@@ -1343,8 +2781,11 @@ static PyObject *vulkan_Device_create_texture2d(vulkan_Device *self, PyObject *a
     py_resource->py_device = py_device;
     Py_INCREF(py_resource->py_device);
 
+    py_resource->usage = usage;
+    py_resource->layout = vulkan_texture_get_layout(usage);
+
     py_resource->image = vulkan_create_image(
-        py_device->device, VK_IMAGE_TYPE_2D, vulkan_formats[format].first, width, height, 1, slices, sparse);
+        py_device->device, VK_IMAGE_TYPE_2D, vulkan_formats[format].first, width, height, 1, slices, mips, sparse, usage);
     if (!py_resource->image)
     {
         Py_DECREF(py_resource);
@@ -1439,39 +2880,20 @@ static PyObject *vulkan_Device_create_texture2d(vulkan_Device *self, PyObject *a
         }
     }
 
-    VkImageViewCreateInfo image_view_create_info = {};
-    image_view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    image_view_create_info.image = py_resource->image;
-    image_view_create_info.viewType = slices > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
-    image_view_create_info.format = vulkan_formats[format].first;
-    image_view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_view_create_info.subresourceRange.levelCount = 1;
-    image_view_create_info.subresourceRange.layerCount = slices;
-
-    VkResult result = vkCreateImageView(
-        py_device->device, &image_view_create_info, NULL, &py_resource->image_view);
-    if (result != VK_SUCCESS)
+    if (!vulkan_texture_create_views(py_resource, slices > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D, vulkan_formats[format].first, slices, mips))
     {
         Py_DECREF(py_resource);
         return PyErr_Format(PyExc_MemoryError, "unable to create vulkan Image View");
     }
 
-    if (!vulkan_texture_set_layout(
-            py_device, py_resource->image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, slices))
-    {
-        Py_DECREF(py_resource);
-        return PyErr_Format(PyExc_MemoryError, "unable to set vulkan Image layout");
-    }
+    vulkan_texture_defer_layout(py_device, py_resource->image, VK_IMAGE_LAYOUT_UNDEFINED, py_resource->layout, slices, mips);
 
     py_resource->image_extent.width = width;
     py_resource->image_extent.height = height;
     py_resource->image_extent.depth = 1;
-    py_resource->descriptor_image_info.imageView = py_resource->image_view;
-    py_resource->descriptor_image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
     py_resource->row_pitch = width * vulkan_formats[format].second;
     py_resource->size = py_resource->row_pitch * height; // always assume a packed configuration
     py_resource->heap_offset = heap_offset;
-    py_resource->format = image_view_create_info.format;
     py_resource->heap_size = requirements.size;
     py_resource->slices = slices;
     py_resource->heap_type = COMPUSHADY_HEAP_DEFAULT;
@@ -1488,7 +2910,12 @@ static PyObject *vulkan_Device_create_texture3d(vulkan_Device *self, PyObject *a
     PyObject *py_heap;
     uint64_t heap_offset;
     PyObject *py_sparse;
-    if (!PyArg_ParseTuple(args, "IIIiOKO", &width, &height, &depth, &format, &py_heap, &heap_offset, &py_sparse))
+    uint32_t mips = 1;
+    uint32_t usage = 0;
+    if (!PyArg_ParseTuple(args, "IIIiOKO|II", &width, &height, &depth, &format, &py_heap, &heap_offset, &py_sparse, &mips, &usage))
+        return NULL;
+
+    if (!vulkan_texture_check_usage(&usage))
         return NULL;
 
     if (width == 0)
@@ -1511,6 +2938,11 @@ static PyObject *vulkan_Device_create_texture3d(vulkan_Device *self, PyObject *a
         return PyErr_Format(PyExc_ValueError, "invalid pixel format");
     }
 
+    if (mips == 0 || mips > compushady_get_max_mips(width, height, depth))
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid number of mips: %u (max %u)", mips, compushady_get_max_mips(width, height, depth));
+    }
+
     const bool sparse = py_sparse && PyObject_IsTrue(py_sparse);
 
     vulkan_Device *py_device = vulkan_Device_get_device(self);
@@ -1522,6 +2954,11 @@ static PyObject *vulkan_Device_create_texture3d(vulkan_Device *self, PyObject *a
         return PyErr_Format(PyExc_ValueError, "sparse resources are not supported");
     }
 
+    if (sparse && mips > 1)
+    {
+        return PyErr_Format(PyExc_ValueError, "sparse resources with mips are not supported");
+    }
+
     vulkan_Resource *py_resource = (vulkan_Resource *)PyObject_New(vulkan_Resource, &vulkan_Resource_Type);
     if (!py_resource)
     {
@@ -1531,8 +2968,11 @@ static PyObject *vulkan_Device_create_texture3d(vulkan_Device *self, PyObject *a
     py_resource->py_device = py_device;
     Py_INCREF(py_resource->py_device);
 
+    py_resource->usage = usage;
+    py_resource->layout = vulkan_texture_get_layout(usage);
+
     py_resource->image = vulkan_create_image(
-        py_device->device, VK_IMAGE_TYPE_3D, vulkan_formats[format].first, width, height, depth, 1, false);
+        py_device->device, VK_IMAGE_TYPE_3D, vulkan_formats[format].first, width, height, depth, 1, mips, false, usage);
     if (!py_resource->image)
     {
         Py_DECREF(py_resource);
@@ -1627,39 +3067,20 @@ static PyObject *vulkan_Device_create_texture3d(vulkan_Device *self, PyObject *a
         }
     }
 
-    VkImageViewCreateInfo image_view_create_info = {};
-    image_view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    image_view_create_info.image = py_resource->image;
-    image_view_create_info.viewType = VK_IMAGE_VIEW_TYPE_3D;
-    image_view_create_info.format = vulkan_formats[format].first;
-    image_view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_view_create_info.subresourceRange.levelCount = 1;
-    image_view_create_info.subresourceRange.layerCount = 1;
-
-    VkResult result = vkCreateImageView(
-        py_device->device, &image_view_create_info, NULL, &py_resource->image_view);
-    if (result != VK_SUCCESS)
+    if (!vulkan_texture_create_views(py_resource, VK_IMAGE_VIEW_TYPE_3D, vulkan_formats[format].first, 1, mips))
     {
         Py_DECREF(py_resource);
         return PyErr_Format(PyExc_MemoryError, "unable to create vulkan Image View");
     }
 
-    if (!vulkan_texture_set_layout(
-            py_device, py_resource->image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 1))
-    {
-        Py_DECREF(py_resource);
-        return PyErr_Format(PyExc_MemoryError, "unable to set vulkan Image layout");
-    }
+    vulkan_texture_defer_layout(py_device, py_resource->image, VK_IMAGE_LAYOUT_UNDEFINED, py_resource->layout, 1, mips);
 
     py_resource->image_extent.width = width;
     py_resource->image_extent.height = height;
     py_resource->image_extent.depth = depth;
-    py_resource->descriptor_image_info.imageView = py_resource->image_view;
-    py_resource->descriptor_image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
     py_resource->row_pitch = width * vulkan_formats[format].second;
     py_resource->size = py_resource->row_pitch * height * depth; // always assume a packed configuration
     py_resource->heap_offset = heap_offset;
-    py_resource->format = image_view_create_info.format;
     py_resource->heap_size = requirements.size;
     py_resource->slices = 1;
     py_resource->heap_type = COMPUSHADY_HEAP_DEFAULT;
@@ -1675,7 +3096,12 @@ static PyObject *vulkan_Device_create_texture1d(vulkan_Device *self, PyObject *a
     uint64_t heap_offset;
     uint32_t slices;
     PyObject *py_sparse;
-    if (!PyArg_ParseTuple(args, "IiOKIO", &width, &format, &py_heap, &heap_offset, &slices, &py_sparse))
+    uint32_t mips = 1;
+    uint32_t usage = 0;
+    if (!PyArg_ParseTuple(args, "IiOKIO|II", &width, &format, &py_heap, &heap_offset, &slices, &py_sparse, &mips, &usage))
+        return NULL;
+
+    if (!vulkan_texture_check_usage(&usage))
         return NULL;
 
     if (width == 0)
@@ -1693,6 +3119,11 @@ static PyObject *vulkan_Device_create_texture1d(vulkan_Device *self, PyObject *a
         return PyErr_Format(PyExc_ValueError, "invalid pixel format");
     }
 
+    if (mips == 0 || mips > compushady_get_max_mips(width, 1, 1))
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid number of mips: %u (max %u)", mips, compushady_get_max_mips(width, 1, 1));
+    }
+
     const bool sparse = py_sparse && PyObject_IsTrue(py_sparse);
 
     vulkan_Device *py_device = vulkan_Device_get_device(self);
@@ -1704,6 +3135,11 @@ static PyObject *vulkan_Device_create_texture1d(vulkan_Device *self, PyObject *a
         return PyErr_Format(PyExc_ValueError, "sparse resources are not supported");
     }
 
+    if (sparse && mips > 1)
+    {
+        return PyErr_Format(PyExc_ValueError, "sparse resources with mips are not supported");
+    }
+
     vulkan_Resource *py_resource = (vulkan_Resource *)PyObject_New(vulkan_Resource, &vulkan_Resource_Type);
     if (!py_resource)
     {
@@ -1713,8 +3149,11 @@ static PyObject *vulkan_Device_create_texture1d(vulkan_Device *self, PyObject *a
     py_resource->py_device = py_device;
     Py_INCREF(py_resource->py_device);
 
+    py_resource->usage = usage;
+    py_resource->layout = vulkan_texture_get_layout(usage);
+
     py_resource->image = vulkan_create_image(
-        py_device->device, VK_IMAGE_TYPE_1D, vulkan_formats[format].first, width, 1, 1, slices, false);
+        py_device->device, VK_IMAGE_TYPE_1D, vulkan_formats[format].first, width, 1, 1, slices, mips, false, usage);
     if (!py_resource->image)
     {
         Py_DECREF(py_resource);
@@ -1808,39 +3247,20 @@ static PyObject *vulkan_Device_create_texture1d(vulkan_Device *self, PyObject *a
         }
     }
 
-    VkImageViewCreateInfo image_view_create_info = {};
-    image_view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    image_view_create_info.image = py_resource->image;
-    image_view_create_info.viewType = slices > 1 ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D;
-    image_view_create_info.format = vulkan_formats[format].first;
-    image_view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_view_create_info.subresourceRange.levelCount = 1;
-    image_view_create_info.subresourceRange.layerCount = slices;
-
-    VkResult result = vkCreateImageView(
-        py_device->device, &image_view_create_info, NULL, &py_resource->image_view);
-    if (result != VK_SUCCESS)
+    if (!vulkan_texture_create_views(py_resource, slices > 1 ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D, vulkan_formats[format].first, slices, mips))
     {
         Py_DECREF(py_resource);
         return PyErr_Format(PyExc_MemoryError, "unable to create vulkan Image View");
     }
 
-    if (!vulkan_texture_set_layout(
-            py_device, py_resource->image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, slices))
-    {
-        Py_DECREF(py_resource);
-        return PyErr_Format(PyExc_MemoryError, "unable to set vulkan Image layout");
-    }
+    vulkan_texture_defer_layout(py_device, py_resource->image, VK_IMAGE_LAYOUT_UNDEFINED, py_resource->layout, slices, mips);
 
     py_resource->image_extent.width = width;
     py_resource->image_extent.height = 1;
     py_resource->image_extent.depth = 1;
-    py_resource->descriptor_image_info.imageView = py_resource->image_view;
-    py_resource->descriptor_image_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
     py_resource->row_pitch = width * vulkan_formats[format].second;
     py_resource->size = py_resource->row_pitch; // always assume a packed configuration
     py_resource->heap_offset = heap_offset;
-    py_resource->format = image_view_create_info.format;
     py_resource->heap_size = requirements.size;
     py_resource->slices = slices;
     py_resource->heap_type = COMPUSHADY_HEAP_DEFAULT;
@@ -1909,6 +3329,7 @@ static PyObject *vulkan_Device_create_sampler(vulkan_Device *self, PyObject *arg
         return PyErr_Format(Compushady_SamplerError, "unsupported filter");
     }
     sampler_create_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_create_info.maxLod = VK_LOD_CLAMP_NONE;
 
     vulkan_Device *py_device = vulkan_Device_get_device(self);
     if (!py_device)
@@ -1936,20 +3357,396 @@ static PyObject *vulkan_Device_create_sampler(vulkan_Device *self, PyObject *arg
     return (PyObject *)py_sampler;
 }
 
-static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *args, PyObject *kwds)
+static void vulkan_Device_destroy_constants_ring(vulkan_Device *py_device)
 {
-    const char *kwlist[] = {"shader", "cbv", "srv", "uav", "samplers", "push_size", "bindless", NULL};
-    Py_buffer view;
-    PyObject *py_cbv = NULL;
-    PyObject *py_srv = NULL;
-    PyObject *py_uav = NULL;
-    PyObject *py_samplers = NULL;
-
-    uint32_t push_size = 0;
-    uint32_t bindless = 0;
+    if (py_device->constants_ring_buffer)
+    {
+        vkDestroyBuffer(py_device->device, py_device->constants_ring_buffer, NULL);
+        py_device->constants_ring_buffer = VK_NULL_HANDLE;
+    }
+    if (py_device->constants_ring_memory)
+    {
+        vkFreeMemory(py_device->device, py_device->constants_ring_memory, NULL);
+        py_device->constants_ring_memory = VK_NULL_HANDLE;
+    }
+    py_device->constants_ring_mapped = NULL;
+}
+
+/*
+ * The constants ring is a device-wide, persistently mapped, uniform buffer used by the Compute pipelines
+ * created with constants_size: every dispatch copies its constants in the next free (aligned) slot
+ * and passes its offset as a dynamic offset.
+ */
+static bool vulkan_Device_get_constants_ring(vulkan_Device *py_device)
+{
+    if (py_device->constants_ring_mapped)
+    {
+        return true;
+    }
+
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = VULKAN_CONSTANTS_RING_SIZE;
+    buffer_create_info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+
+    VkResult result = vkCreateBuffer(py_device->device, &buffer_create_info, NULL, &py_device->constants_ring_buffer);
+    if (result != VK_SUCCESS)
+    {
+        py_device->constants_ring_buffer = VK_NULL_HANDLE;
+        PyErr_Format(Compushady_BufferError, "unable to create vulkan constants ring Buffer");
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(py_device->device, py_device->constants_ring_buffer, &requirements);
+
+    const VkMemoryPropertyFlags mem_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    VkMemoryAllocateInfo allocate_info = {};
+    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocate_info.allocationSize = requirements.size;
+    allocate_info.memoryTypeIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < py_device->mem_props.memoryTypeCount; i++)
+    {
+        if ((requirements.memoryTypeBits & (1 << i)) && (py_device->mem_props.memoryTypes[i].propertyFlags & mem_flags) == mem_flags)
+        {
+            allocate_info.memoryTypeIndex = i;
+            break;
+        }
+    }
+
+    if (allocate_info.memoryTypeIndex == UINT32_MAX)
+    {
+        vulkan_Device_destroy_constants_ring(py_device);
+        PyErr_Format(Compushady_BufferError, "unable to find a host coherent memory type for the constants ring");
+        return false;
+    }
+
+    result = vkAllocateMemory(py_device->device, &allocate_info, NULL, &py_device->constants_ring_memory);
+    if (result != VK_SUCCESS)
+    {
+        py_device->constants_ring_memory = VK_NULL_HANDLE;
+        vulkan_Device_destroy_constants_ring(py_device);
+        PyErr_Format(Compushady_BufferError, "unable to create vulkan constants ring memory");
+        return false;
+    }
+
+    result = vkBindBufferMemory(py_device->device, py_device->constants_ring_buffer, py_device->constants_ring_memory, 0);
+    if (result != VK_SUCCESS)
+    {
+        vulkan_Device_destroy_constants_ring(py_device);
+        PyErr_Format(Compushady_BufferError, "unable to bind vulkan constants ring memory");
+        return false;
+    }
+
+    result = vkMapMemory(py_device->device, py_device->constants_ring_memory, 0, VULKAN_CONSTANTS_RING_SIZE, 0, (void **)&py_device->constants_ring_mapped);
+    if (result != VK_SUCCESS)
+    {
+        vulkan_Device_destroy_constants_ring(py_device);
+        PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        return false;
+    }
+
+    py_device->constants_ring_offset = 0;
+
+    return true;
+}
+
+/*
+ * Copies the constants in the ring and returns their (dynamic) offset.
+ * Before wrapping around, the submissions still in flight (that may read the ring) are waited for, a batch
+ * is split by submitting (and waiting for) the commands recorded so far: nothing must be recorded in the
+ * command buffer between vulkan_Device_begin() and this call.
+ */
+static uint32_t vulkan_Device_write_constants(vulkan_Device *py_device, const void *data, const uint32_t size)
+{
+    const uint32_t alignment = py_device->min_uniform_buffer_offset_alignment > 0 ? py_device->min_uniform_buffer_offset_alignment : 256;
+    uint32_t offset = ((py_device->constants_ring_offset + alignment - 1) / alignment) * alignment;
+    if (offset + size > VULKAN_CONSTANTS_RING_SIZE)
+    {
+        if (py_device->recording_batch)
+        {
+            py_device->recording_batch = false;
+            vulkan_Device_submit_and_wait(py_device);
+            vulkan_Device_begin(py_device);
+            py_device->recording_batch = true;
+        }
+        else if (py_device->completed_serial < py_device->submitted_serial)
+        {
+            vulkan_Device_wait(py_device);
+        }
+        offset = 0;
+    }
+    memcpy(py_device->constants_ring_mapped + offset, data, size);
+    py_device->constants_ring_offset = offset + size;
+    return offset;
+}
+
+/*
+ * The bindless heap is a device-wide descriptor set (set 1 in shaders) shared by all of the Compute pipelines:
+ * binding 0 is an array of CBVs, binding 1 an array of (mutable) SRVs and binding 2 an array of (mutable) UAVs.
+ * Each resource gets a stable index in all of the arrays the first time it is registered.
+ */
+static bool vulkan_Device_get_bindless_heap(vulkan_Device *py_device)
+{
+    if (py_device->bindless_heap_set)
+    {
+        return true;
+    }
+
+    if (!py_device->supports_bindless)
+    {
+        PyErr_Format(PyExc_ValueError, "Bindless heap is not supported");
+        return false;
+    }
+
+#if VK_EXT_descriptor_indexing && (VK_EXT_mutable_descriptor_type || VK_VALVE_mutable_descriptor_type)
+    static const VkDescriptorType srv_mutable_types[] = {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE};
+    static const VkDescriptorType uav_mutable_types[] = {VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE};
+
+#ifdef VK_EXT_mutable_descriptor_type
+    const VkDescriptorType mutable_type = VK_DESCRIPTOR_TYPE_MUTABLE_EXT;
+    VkMutableDescriptorTypeListEXT mutable_list[3] = {};
+    VkMutableDescriptorTypeCreateInfoEXT mutable_descriptor_type_create_info = {};
+    mutable_descriptor_type_create_info.sType = VK_STRUCTURE_TYPE_MUTABLE_DESCRIPTOR_TYPE_CREATE_INFO_EXT;
+#else
+    const VkDescriptorType mutable_type = VK_DESCRIPTOR_TYPE_MUTABLE_VALVE;
+    VkMutableDescriptorTypeListVALVE mutable_list[3] = {};
+    VkMutableDescriptorTypeCreateInfoVALVE mutable_descriptor_type_create_info = {};
+    mutable_descriptor_type_create_info.sType = VK_STRUCTURE_TYPE_MUTABLE_DESCRIPTOR_TYPE_CREATE_INFO_VALVE;
+#endif
+    mutable_list[1].descriptorTypeCount = 3;
+    mutable_list[1].pDescriptorTypes = srv_mutable_types;
+    mutable_list[2].descriptorTypeCount = 3;
+    mutable_list[2].pDescriptorTypes = uav_mutable_types;
+    mutable_descriptor_type_create_info.mutableDescriptorTypeListCount = 3;
+    mutable_descriptor_type_create_info.pMutableDescriptorTypeLists = mutable_list;
+
+    VkDescriptorSetLayoutBinding layout_bindings[3] = {};
+    VkDescriptorBindingFlags layout_bindings_flags[3] = {};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        layout_bindings[i].binding = i;
+        layout_bindings[i].descriptorCount = VULKAN_BINDLESS_HEAP_SIZE;
+        layout_bindings[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : mutable_type;
+        layout_bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        layout_bindings_flags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_create_info = {};
+    binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    binding_flags_create_info.pNext = &mutable_descriptor_type_create_info;
+    binding_flags_create_info.bindingCount = 3;
+    binding_flags_create_info.pBindingFlags = layout_bindings_flags;
+
+    VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info = {};
+    descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptor_set_layout_create_info.pNext = &binding_flags_create_info;
+    descriptor_set_layout_create_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    descriptor_set_layout_create_info.bindingCount = 3;
+    descriptor_set_layout_create_info.pBindings = layout_bindings;
+
+    VkResult result = vkCreateDescriptorSetLayout(py_device->device, &descriptor_set_layout_create_info, NULL, &py_device->bindless_heap_layout);
+    if (result != VK_SUCCESS)
+    {
+        PyErr_Format(PyExc_Exception, "Unable to create bindless heap Descriptor Set Layout");
+        return false;
+    }
+
+    VkDescriptorPoolSize pool_sizes[2] = {};
+    pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    pool_sizes[0].descriptorCount = VULKAN_BINDLESS_HEAP_SIZE;
+    pool_sizes[1].type = mutable_type;
+    pool_sizes[1].descriptorCount = VULKAN_BINDLESS_HEAP_SIZE * 2;
+
+    VkDescriptorPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    pool_info.poolSizeCount = 2;
+    pool_info.pPoolSizes = pool_sizes;
+    pool_info.maxSets = 1;
+
+    result = vkCreateDescriptorPool(py_device->device, &pool_info, NULL, &py_device->bindless_heap_pool);
+    if (result != VK_SUCCESS)
+    {
+        PyErr_Format(PyExc_Exception, "Unable to create bindless heap Descriptor Pool");
+        return false;
+    }
+
+    VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {};
+    descriptor_set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptor_set_allocate_info.descriptorPool = py_device->bindless_heap_pool;
+    descriptor_set_allocate_info.descriptorSetCount = 1;
+    descriptor_set_allocate_info.pSetLayouts = &py_device->bindless_heap_layout;
+
+    result = vkAllocateDescriptorSets(py_device->device, &descriptor_set_allocate_info, &py_device->bindless_heap_set);
+    if (result != VK_SUCCESS)
+    {
+        PyErr_Format(PyExc_Exception, "Unable to create bindless heap Descriptor Set");
+        return false;
+    }
+
+    py_device->bindless_heap_free = new std::vector<uint32_t>();
+
+    return true;
+#else
+    PyErr_Format(PyExc_ValueError, "Bindless heap is not supported");
+    return false;
+#endif
+}
+
+// kind is 0 for CBVs, 1 for SRVs and 2 for UAVs
+static bool vulkan_Resource_check_usage(vulkan_Resource *self, const uint32_t kind)
+{
+    const uint32_t usage = kind == 2 ? COMPUSHADY_USAGE_STORAGE : COMPUSHADY_USAGE_READ_ONLY;
+    if (!(self->usage & usage))
+    {
+        const char *names[] = {"CBV", "SRV", "UAV"};
+        PyErr_Format(PyExc_ValueError, "resource cannot be used as %s (usage %u)", names[kind], self->usage);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Assigns (once) an index in the bindless heap to the resource and writes its descriptors.
+ */
+static bool vulkan_Resource_register_bindless(vulkan_Resource *self)
+{
+    if (self->has_bindless_index)
+    {
+        return true;
+    }
+
+    vulkan_Device *py_device = self->py_device;
+    if (!vulkan_Device_get_bindless_heap(py_device))
+    {
+        return false;
+    }
+
+    uint32_t index;
+    if (!py_device->bindless_heap_free->empty())
+    {
+        index = py_device->bindless_heap_free->back();
+        py_device->bindless_heap_free->pop_back();
+    }
+    else if (py_device->bindless_heap_next < VULKAN_BINDLESS_HEAP_SIZE)
+    {
+        index = py_device->bindless_heap_next++;
+    }
+    else
+    {
+        PyErr_Format(PyExc_ValueError, "Bindless heap is full (max %u resources)", VULKAN_BINDLESS_HEAP_SIZE);
+        return false;
+    }
+
+    VkWriteDescriptorSet write_descriptor_sets[3] = {};
+    uint32_t writes = 0;
+
+    VkDescriptorBufferInfo cbv_buffer_info = self->descriptor_buffer_info;
+    if (self->buffer && !self->buffer_view && (self->usage & COMPUSHADY_USAGE_READ_ONLY))
+    {
+        if (cbv_buffer_info.range > py_device->max_uniform_buffer_range)
+        {
+            cbv_buffer_info.range = py_device->max_uniform_buffer_range;
+        }
+        write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        write_descriptor_sets[writes].dstBinding = 0;
+        write_descriptor_sets[writes].pBufferInfo = &cbv_buffer_info;
+        writes++;
+    }
+
+    // SRV
+    if (self->usage & COMPUSHADY_USAGE_READ_ONLY)
+    {
+        write_descriptor_sets[writes].dstBinding = 1;
+        if (self->buffer)
+        {
+            if (self->buffer_view)
+            {
+                write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                write_descriptor_sets[writes].pTexelBufferView = &self->buffer_view;
+            }
+            else
+            {
+                write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write_descriptor_sets[writes].pBufferInfo = &self->descriptor_buffer_info;
+            }
+        }
+        else
+        {
+            write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            write_descriptor_sets[writes].pImageInfo = &self->descriptor_image_info;
+        }
+        writes++;
+    }
+
+    // UAV
+    if (self->usage & COMPUSHADY_USAGE_STORAGE)
+    {
+        write_descriptor_sets[writes].dstBinding = 2;
+        if (self->buffer)
+        {
+            if (self->buffer_view)
+            {
+                write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+                write_descriptor_sets[writes].pTexelBufferView = &self->buffer_view;
+            }
+            else
+            {
+                write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write_descriptor_sets[writes].pBufferInfo = &self->descriptor_buffer_info;
+            }
+        }
+        else
+        {
+            write_descriptor_sets[writes].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            write_descriptor_sets[writes].pImageInfo = &self->descriptor_storage_image_info;
+        }
+        writes++;
+    }
+
+    for (uint32_t i = 0; i < writes; i++)
+    {
+        write_descriptor_sets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_descriptor_sets[i].dstSet = py_device->bindless_heap_set;
+        write_descriptor_sets[i].dstArrayElement = index;
+        write_descriptor_sets[i].descriptorCount = 1;
+    }
+
+    vkUpdateDescriptorSets(py_device->device, writes, write_descriptor_sets, 0, NULL);
+
+    self->bindless_index = index;
+    self->has_bindless_index = true;
+    return true;
+}
+
+static PyObject *vulkan_Resource_get_bindless_index(vulkan_Resource *self, PyObject *args)
+{
+    if (!vulkan_Resource_register_bindless(self))
+    {
+        return NULL;
+    }
+
+    return PyLong_FromUnsignedLong(self->bindless_index);
+}
+
+static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *args, PyObject *kwds)
+{
+    const char *kwlist[] = {"shader", "cbv", "srv", "uav", "samplers", "push_size", "bindless", "subgroup_size", "push_descriptors", "constants_size", NULL};
+    Py_buffer view;
+    PyObject *py_cbv = NULL;
+    PyObject *py_srv = NULL;
+    PyObject *py_uav = NULL;
+    PyObject *py_samplers = NULL;
+
+    uint32_t push_size = 0;
+    uint32_t bindless = 0;
+    uint32_t subgroup_size = 0;
+    int push_descriptors = 0;
+    uint32_t constants_size = 0;
 
     if (!PyArg_ParseTupleAndKeywords(
-            args, kwds, "y*|OOOOII", (char **)kwlist, &view, &py_cbv, &py_srv, &py_uav, &py_samplers, &push_size, &bindless))
+            args, kwds, "y*|OOOOIIIpI", (char **)kwlist, &view, &py_cbv, &py_srv, &py_uav, &py_samplers, &push_size, &bindless, &subgroup_size, &push_descriptors, &constants_size))
         return NULL;
 
     if (push_size > 0 && (push_size % 4) != 0)
@@ -1967,6 +3764,57 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         return PyErr_Format(PyExc_ValueError, "Bindless Compute pipeline is not supported");
     }
 
+    if (push_descriptors)
+    {
+        if (!py_device->supports_push_descriptors)
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError, "push descriptors are not supported");
+        }
+
+        if (bindless > 0)
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError, "push descriptors cannot be used with a bindless Compute pipeline");
+        }
+    }
+
+    if (constants_size > 0)
+    {
+        if (bindless > 0 || push_descriptors)
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError, "constants cannot be used with bindless or push descriptors Compute pipelines");
+        }
+
+        if (constants_size > py_device->max_uniform_buffer_range || constants_size > VULKAN_CONSTANTS_RING_SIZE)
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError, "invalid constants size %u (max: %u)", constants_size, py_device->max_uniform_buffer_range < VULKAN_CONSTANTS_RING_SIZE ? py_device->max_uniform_buffer_range : VULKAN_CONSTANTS_RING_SIZE);
+        }
+
+        if (!vulkan_Device_get_constants_ring(py_device))
+        {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+    }
+
+    if (subgroup_size > 0)
+    {
+        if (!py_device->supports_subgroup_size_control)
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError, "subgroup size control is not supported");
+        }
+
+        if (subgroup_size < py_device->min_subgroup_size || subgroup_size > py_device->max_subgroup_size || (subgroup_size & (subgroup_size - 1)))
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError, "invalid subgroup size %u (expected a power of two between %u and %u)", subgroup_size, py_device->min_subgroup_size, py_device->max_subgroup_size);
+        }
+    }
+
     std::vector<vulkan_Resource *> cbv;
     std::vector<vulkan_Resource *> srv;
     std::vector<vulkan_Resource *> uav;
@@ -1978,6 +3826,19 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         return NULL;
     }
 
+    const std::vector<vulkan_Resource *> *descriptor_lists[] = {&cbv, &srv, &uav};
+    for (uint32_t kind = 0; kind < 3; kind++)
+    {
+        for (vulkan_Resource *py_resource : *descriptor_lists[kind])
+        {
+            if (!vulkan_Resource_check_usage(py_resource, kind))
+            {
+                PyBuffer_Release(&view);
+                return NULL;
+            }
+        }
+    }
+
     std::vector<VkDescriptorSetLayoutBinding> layout_bindings;
 #ifdef VK_EXT_descriptor_indexing
     std::vector<VkDescriptorBindingFlags> layout_bindings_flags;
@@ -2008,12 +3869,36 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
     shader_create_info.codeSize = view.len;
     shader_create_info.pCode = (uint32_t *)(view.buf);
 
+    vulkan_SPIRVReflection reflection;
+    if (!vulkan_reflect_spirv(shader_create_info.pCode, shader_create_info.codeSize, reflection))
+    {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    // unused bindings are skipped (unless in bindless mode where the whole range is always available)
+    auto binding_used = [&](const uint32_t binding)
+    {
+        return bindless > 0 || reflection.bindings.count(binding) > 0;
+    };
+
+    if (reflection.push_constant_size > push_size)
+    {
+        push_size = (reflection.push_constant_size + 3) & ~3;
+    }
+
     uint32_t binding_offset = 0;
 
     if (bindless == 0)
     {
         for (vulkan_Resource *py_resource : cbv)
         {
+            const uint32_t binding = binding_offset++;
+            if (!binding_used(binding))
+            {
+                continue;
+            }
+
             if (descriptors.find(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) == descriptors.end())
             {
                 descriptors[VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER] = {};
@@ -2021,37 +3906,69 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
             descriptors[VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER].push_back(py_resource);
 
             VkDescriptorSetLayoutBinding layout_binding = {};
-            layout_binding.binding = binding_offset++;
+            layout_binding.binding = binding;
             layout_binding.descriptorCount = 1;
             layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
             layout_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
             layout_bindings.push_back(layout_binding);
         }
 
-        binding_offset = 1024;
-        for (vulkan_Resource *py_resource : srv)
+        // the constants take the CBV slot following the ones passed as resources
+        if (constants_size > 0)
         {
-            VkDescriptorType type = py_resource->buffer ? py_resource->buffer_view
-                                                              ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER
-                                                              : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
-                                                        : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-            if (descriptors.find(type) == descriptors.end())
+            const uint32_t binding = binding_offset;
+            if (!binding_used(binding))
             {
-                descriptors[type] = {};
+                PyBuffer_Release(&view);
+                return PyErr_Format(PyExc_ValueError, "shader does not use the constants CBV (register b%u)", binding);
             }
-            descriptors[type].push_back(py_resource);
+
+            descriptors[VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC] = {nullptr};
 
             VkDescriptorSetLayoutBinding layout_binding = {};
-            layout_binding.binding = binding_offset++;
+            layout_binding.binding = binding;
             layout_binding.descriptorCount = 1;
-            layout_binding.descriptorType = type;
+            layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             layout_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
             layout_bindings.push_back(layout_binding);
         }
 
-        binding_offset = 2048;
+        binding_offset = 1024;
+        for (vulkan_Resource *py_resource : srv)
+        {
+            const uint32_t binding = binding_offset++;
+            if (!binding_used(binding))
+            {
+                continue;
+            }
+
+            VkDescriptorType type = py_resource->buffer ? py_resource->buffer_view
+                                                              ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER
+                                                              : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+                                                        : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            if (descriptors.find(type) == descriptors.end())
+            {
+                descriptors[type] = {};
+            }
+            descriptors[type].push_back(py_resource);
+
+            VkDescriptorSetLayoutBinding layout_binding = {};
+            layout_binding.binding = binding;
+            layout_binding.descriptorCount = 1;
+            layout_binding.descriptorType = type;
+            layout_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            layout_bindings.push_back(layout_binding);
+        }
+
+        binding_offset = 2048;
         for (vulkan_Resource *py_resource : uav)
         {
+            const uint32_t binding = binding_offset++;
+            if (!binding_used(binding))
+            {
+                continue;
+            }
+
             VkDescriptorType type = py_resource->buffer ? py_resource->buffer_view
                                                               ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
                                                               : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
@@ -2063,7 +3980,7 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
             descriptors[type].push_back(py_resource);
 
             VkDescriptorSetLayoutBinding layout_binding = {};
-            layout_binding.binding = binding_offset++;
+            layout_binding.binding = binding;
             layout_binding.descriptorCount = 1;
             layout_binding.descriptorType = type;
             layout_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
@@ -2162,18 +4079,45 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
     binding_offset = 0;
     for (vulkan_Resource *py_resource : cbv)
     {
+        const uint32_t binding = binding_offset++;
+        if (!binding_used(binding))
+        {
+            continue;
+        }
+
         VkWriteDescriptorSet write_descriptor_set = {};
         write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         write_descriptor_set.descriptorCount = 1;
         write_descriptor_set.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        write_descriptor_set.dstBinding = binding_offset;
+        write_descriptor_set.dstBinding = binding;
         write_descriptor_set.pBufferInfo = &py_resource->descriptor_buffer_info;
         write_descriptor_sets.push_back(write_descriptor_set);
     }
 
+    VkDescriptorBufferInfo constants_buffer_info = {};
+    if (constants_size > 0)
+    {
+        constants_buffer_info.buffer = py_device->constants_ring_buffer;
+        constants_buffer_info.range = constants_size;
+
+        VkWriteDescriptorSet write_descriptor_set = {};
+        write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_descriptor_set.descriptorCount = 1;
+        write_descriptor_set.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        write_descriptor_set.dstBinding = binding_offset;
+        write_descriptor_set.pBufferInfo = &constants_buffer_info;
+        write_descriptor_sets.push_back(write_descriptor_set);
+    }
+
     binding_offset = 1024;
     for (vulkan_Resource *py_resource : srv)
     {
+        const uint32_t binding = binding_offset++;
+        if (!binding_used(binding))
+        {
+            continue;
+        }
+
         VkDescriptorType type = py_resource->buffer ? py_resource->buffer_view
                                                           ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER
                                                           : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
@@ -2183,7 +4127,7 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         write_descriptor_set.descriptorCount = 1;
         write_descriptor_set.descriptorType = type;
-        write_descriptor_set.dstBinding = binding_offset++;
+        write_descriptor_set.dstBinding = binding;
         if (py_resource->buffer)
         {
             if (py_resource->buffer_view)
@@ -2205,6 +4149,12 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
     binding_offset = 2048;
     for (vulkan_Resource *py_resource : uav)
     {
+        const uint32_t binding = binding_offset++;
+        if (!binding_used(binding))
+        {
+            continue;
+        }
+
         VkDescriptorType type = py_resource->buffer ? py_resource->buffer_view
                                                           ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
                                                           : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
@@ -2214,7 +4164,7 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         write_descriptor_set.descriptorCount = 1;
         write_descriptor_set.descriptorType = type;
-        write_descriptor_set.dstBinding = binding_offset++;
+        write_descriptor_set.dstBinding = binding;
         if (py_resource->buffer)
         {
             if (py_resource->buffer_view)
@@ -2228,13 +4178,13 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         }
         else
         {
-            write_descriptor_set.pImageInfo = &py_resource->descriptor_image_info;
+            write_descriptor_set.pImageInfo = &py_resource->descriptor_storage_image_info;
             if (!py_device->features.shaderStorageImageReadWithoutFormat)
             {
-                if (py_resource->format == VK_FORMAT_B8G8R8A8_UNORM || py_resource->format == VK_FORMAT_B8G8R8A8_SRGB)
+                if ((py_resource->format == VK_FORMAT_B8G8R8A8_UNORM || py_resource->format == VK_FORMAT_B8G8R8A8_SRGB) && reflection.non_readable_bindings.count(binding) == 0)
                 {
                     uint32_t *patched_blob = vulkan_patch_spirv_unknown_uav(
-                        shader_create_info.pCode, shader_create_info.codeSize, binding_offset);
+                        shader_create_info.pCode, shader_create_info.codeSize, binding);
                     if (patched_blob)
                     {
                         // first free old blob if required
@@ -2252,6 +4202,12 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
     binding_offset = 3072;
     for (vulkan_Sampler *py_sampler : samplers)
     {
+        const uint32_t binding = binding_offset++;
+        if (!binding_used(binding))
+        {
+            continue;
+        }
+
         if (descriptors.find(VK_DESCRIPTOR_TYPE_SAMPLER) == descriptors.end())
         {
             descriptors[VK_DESCRIPTOR_TYPE_SAMPLER] = {};
@@ -2262,12 +4218,12 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         write_descriptor_set.descriptorCount = 1;
         write_descriptor_set.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-        write_descriptor_set.dstBinding = binding_offset;
+        write_descriptor_set.dstBinding = binding;
         write_descriptor_set.pImageInfo = &py_sampler->descriptor_image_info;
         write_descriptor_sets.push_back(write_descriptor_set);
 
         VkDescriptorSetLayoutBinding layout_binding = {};
-        layout_binding.binding = binding_offset++;
+        layout_binding.binding = binding;
         layout_binding.descriptorCount = 1;
         layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
         layout_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
@@ -2286,18 +4242,13 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         }
     }
 
-    const char *entry_point = vulkan_get_spirv_entry_point(shader_create_info.pCode, shader_create_info.codeSize);
-    if (!entry_point)
-    {
-        if (shader_create_info.pCode != view.buf)
-            PyMem_Free((void *)shader_create_info.pCode);
-        PyBuffer_Release(&view);
-        return PyErr_Format(
-            PyExc_ValueError, "Invalid SPIR-V Shader, expected a GLCompute OpEntryPoint");
-    }
-
+    // shader module and pipeline creation can be really slow on some drivers, so the GIL is released
+    // (the descriptors have already been validated and the input buffer is still locked)
     VkShaderModule shader_module;
-    VkResult result = vkCreateShaderModule(py_device->device, &shader_create_info, nullptr, &shader_module);
+    VkResult result;
+    Py_BEGIN_ALLOW_THREADS;
+    result = vkCreateShaderModule(py_device->device, &shader_create_info, nullptr, &shader_module);
+    Py_END_ALLOW_THREADS;
     if (result != VK_SUCCESS)
     {
         if (shader_create_info.pCode != view.buf)
@@ -2323,6 +4274,32 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
 
     py_compute->push_constant_size = push_size;
     py_compute->bindless = bindless;
+    if (constants_size > 0)
+    {
+        py_compute->constants_size = constants_size;
+        py_compute->constants = new std::vector<uint8_t>(constants_size);
+    }
+    py_compute->thread_group_size_x = reflection.thread_group_size[0];
+    py_compute->thread_group_size_y = reflection.thread_group_size[1];
+    py_compute->thread_group_size_z = reflection.thread_group_size[2];
+
+    py_compute->py_bindings = PyTuple_New((Py_ssize_t)reflection.bindings.size());
+    if (!py_compute->py_bindings)
+    {
+        Py_DECREF(py_compute);
+        return NULL;
+    }
+    Py_ssize_t binding_index = 0;
+    for (const uint32_t binding : reflection.bindings)
+    {
+        PyObject *py_binding = PyLong_FromUnsignedLong(binding);
+        if (!py_binding)
+        {
+            Py_DECREF(py_compute);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(py_compute->py_bindings, binding_index++, py_binding);
+    }
 
     VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info = {};
     descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -2355,6 +4332,18 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
 #endif
     }
 
+    if (push_descriptors)
+    {
+        if (write_descriptor_sets.size() > py_device->max_push_descriptors)
+        {
+            Py_DECREF(py_compute);
+            return PyErr_Format(PyExc_ValueError, "too many descriptors (%u) for push descriptors (max: %u)", (uint32_t)write_descriptor_sets.size(), py_device->max_push_descriptors);
+        }
+#ifdef VK_KHR_push_descriptor
+        descriptor_set_layout_create_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+#endif
+    }
+
     result = vkCreateDescriptorSetLayout(py_device->device, &descriptor_set_layout_create_info,
                                          NULL, &py_compute->descriptor_set_layout);
     if (result != VK_SUCCESS)
@@ -2363,59 +4352,83 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
         return PyErr_Format(PyExc_Exception, "Unable to create Descriptor Set Layout");
     }
 
-    VkDescriptorPoolCreateInfo pool_info = {};
-    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    if (bindless > 0)
+    // push descriptors do not require a pool nor a descriptor set, the writes are recorded at dispatch time
+    if (push_descriptors)
     {
-#ifdef VK_EXT_descriptor_indexing
-        pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
-#endif
+        py_compute->push_descriptors = true;
+        py_compute->push_writes = new std::vector<VkWriteDescriptorSet>(write_descriptor_sets);
     }
     else
     {
-        pool_info.poolSizeCount = (uint32_t)pool_sizes.size();
-        pool_info.pPoolSizes = pool_sizes.data();
-    }
-    pool_info.maxSets = 1;
-
-    result = vkCreateDescriptorPool(py_device->device, &pool_info, NULL, &py_compute->descriptor_pool);
-    if (result != VK_SUCCESS)
-    {
-        Py_DECREF(py_compute);
-        return PyErr_Format(PyExc_Exception, "Unable to create Descriptor Pool");
-    }
+        VkDescriptorPoolCreateInfo pool_info = {};
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        if (bindless > 0)
+        {
+#ifdef VK_EXT_descriptor_indexing
+            pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+#endif
+        }
+        else
+        {
+            pool_info.poolSizeCount = (uint32_t)pool_sizes.size();
+            pool_info.pPoolSizes = pool_sizes.data();
+        }
+        pool_info.maxSets = 1;
 
-    VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {};
-    descriptor_set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    descriptor_set_allocate_info.descriptorPool = py_compute->descriptor_pool;
-    descriptor_set_allocate_info.descriptorSetCount = 1;
-    descriptor_set_allocate_info.pSetLayouts = &py_compute->descriptor_set_layout;
+        result = vkCreateDescriptorPool(py_device->device, &pool_info, NULL, &py_compute->descriptor_pool);
+        if (result != VK_SUCCESS)
+        {
+            Py_DECREF(py_compute);
+            return PyErr_Format(PyExc_Exception, "Unable to create Descriptor Pool");
+        }
 
-    result = vkAllocateDescriptorSets(
-        py_device->device, &descriptor_set_allocate_info, &py_compute->descriptor_set);
-    if (result != VK_SUCCESS)
-    {
-        Py_DECREF(py_compute);
-        return PyErr_Format(PyExc_Exception, "Unable to create Descriptor Set");
-    }
+        VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {};
+        descriptor_set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        descriptor_set_allocate_info.descriptorPool = py_compute->descriptor_pool;
+        descriptor_set_allocate_info.descriptorSetCount = 1;
+        descriptor_set_allocate_info.pSetLayouts = &py_compute->descriptor_set_layout;
 
-    if (write_descriptor_sets.size() > 0)
-    {
-        // update descriptors
-        for (VkWriteDescriptorSet &write_descriptor_set : write_descriptor_sets)
+        result = vkAllocateDescriptorSets(
+            py_device->device, &descriptor_set_allocate_info, &py_compute->descriptor_set);
+        if (result != VK_SUCCESS)
         {
-            write_descriptor_set.dstSet = py_compute->descriptor_set;
+            Py_DECREF(py_compute);
+            return PyErr_Format(PyExc_Exception, "Unable to create Descriptor Set");
         }
 
-        vkUpdateDescriptorSets(py_device->device, (uint32_t)write_descriptor_sets.size(),
-                               write_descriptor_sets.data(), 0, NULL);
+        if (write_descriptor_sets.size() > 0)
+        {
+            // update descriptors
+            for (VkWriteDescriptorSet &write_descriptor_set : write_descriptor_sets)
+            {
+                write_descriptor_set.dstSet = py_compute->descriptor_set;
+            }
+
+            vkUpdateDescriptorSets(py_device->device, (uint32_t)write_descriptor_sets.size(),
+                                   write_descriptor_sets.data(), 0, NULL);
+        }
     }
 
+    VkDescriptorSetLayout set_layouts[2] = {py_compute->descriptor_set_layout, VK_NULL_HANDLE};
+
     VkPipelineLayoutCreateInfo layout_create_info = {};
     layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    layout_create_info.pSetLayouts = &py_compute->descriptor_set_layout;
+    layout_create_info.pSetLayouts = set_layouts;
     layout_create_info.setLayoutCount = 1;
 
+    // shaders accessing descriptor set 1 automatically get the device bindless heap
+    if (reflection.uses_bindless_heap)
+    {
+        if (!vulkan_Device_get_bindless_heap(py_device))
+        {
+            Py_DECREF(py_compute);
+            return NULL;
+        }
+        set_layouts[VULKAN_BINDLESS_HEAP_SET] = py_device->bindless_heap_layout;
+        layout_create_info.setLayoutCount = 2;
+        py_compute->uses_bindless_heap = true;
+    }
+
     VkPushConstantRange push_constant = {};
     if (push_size > 0)
     {
@@ -2437,16 +4450,28 @@ static PyObject *vulkan_Device_create_compute(vulkan_Device *self, PyObject *arg
     VkPipelineShaderStageCreateInfo stage_create_info = {};
     stage_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stage_create_info.module = shader_module;
-    stage_create_info.pName = entry_point;
+    stage_create_info.pName = reflection.entry_point.c_str();
     stage_create_info.stage = VK_SHADER_STAGE_COMPUTE_BIT;
 
+#ifdef VK_EXT_subgroup_size_control
+    VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT required_subgroup_size_create_info = {};
+    if (subgroup_size > 0)
+    {
+        required_subgroup_size_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT;
+        required_subgroup_size_create_info.requiredSubgroupSize = subgroup_size;
+        stage_create_info.pNext = &required_subgroup_size_create_info;
+    }
+#endif
+
     VkComputePipelineCreateInfo pipeline_create_info = {};
     pipeline_create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     pipeline_create_info.stage = stage_create_info;
     pipeline_create_info.layout = py_compute->pipeline_layout;
 
+    Py_BEGIN_ALLOW_THREADS;
     result = vkCreateComputePipelines(py_device->device, VK_NULL_HANDLE, 1, &pipeline_create_info,
                                       nullptr, &py_compute->pipeline);
+    Py_END_ALLOW_THREADS;
     if (result != VK_SUCCESS)
     {
         Py_DECREF(py_compute);
@@ -2695,7 +4720,7 @@ static PyObject *vulkan_Device_create_swapchain(vulkan_Device *self, PyObject *a
     for (VkImage image : py_swapchain->images)
     {
         if (!vulkan_texture_set_layout(
-                py_device, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 1))
+                py_device, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 1, 1))
         {
             Py_DECREF(py_swapchain);
             return PyErr_Format(PyExc_Exception, "Unable to update vulkan Swapchain images layout");
@@ -2725,890 +4750,2332 @@ static PyObject *vulkan_Device_create_swapchain(vulkan_Device *self, PyObject *a
     return (PyObject *)py_swapchain;
 }
 
-static PyObject *vulkan_Device_get_debug_messages(vulkan_Device *self, PyObject *args)
+static PyObject *vulkan_Device_change_features(vulkan_Device *self, PyObject *args, const bool request)
 {
-    PyObject *py_list = PyList_New(0);
+    PyObject *py_features;
+    if (!PyArg_ParseTuple(args, "O", &py_features))
+        return NULL;
 
-    for (const std::string &message : vulkan_debug_messages)
+    if (self->device)
     {
-        PyList_Append(py_list, PyUnicode_FromString(message.c_str()));
+        return PyErr_Format(PyExc_ValueError, "features can be changed only before the device is initialized");
     }
-    vulkan_debug_messages = {};
-
-    return py_list;
-}
-
-static PyMethodDef vulkan_Device_methods[] = {
-    {"create_buffer", (PyCFunction)vulkan_Device_create_buffer, METH_VARARGS,
-     "Creates a Buffer object"},
-    {"create_texture1d", (PyCFunction)vulkan_Device_create_texture1d, METH_VARARGS,
-     "Creates a Texture1D object"},
-    {"create_texture2d", (PyCFunction)vulkan_Device_create_texture2d, METH_VARARGS,
-     "Creates a Texture2D object"},
-    {"create_texture3d", (PyCFunction)vulkan_Device_create_texture3d, METH_VARARGS,
-     "Creates a Texture3D object"},
-    {"get_debug_messages", (PyCFunction)vulkan_Device_get_debug_messages, METH_VARARGS,
-     "Get Device's debug messages"},
-    {"create_compute", (PyCFunction)vulkan_Device_create_compute, METH_VARARGS | METH_KEYWORDS,
-     "Creates a Compute object"},
-    {"create_swapchain", (PyCFunction)vulkan_Device_create_swapchain, METH_VARARGS,
-     "Creates a Swapchain object"},
-    {"create_sampler", (PyCFunction)vulkan_Device_create_sampler, METH_VARARGS,
-     "Creates a Sampler object"},
-    {"create_heap", (PyCFunction)vulkan_Device_create_heap, METH_VARARGS,
-     "Creates a Heap object"},
-    {NULL, NULL, 0, NULL} /* Sentinel */
-};
 
-static PyObject *vulkan_get_discovered_devices(PyObject *self)
-{
-    if (!vulkan_instance_check())
+    PyObject *py_iter = PyObject_GetIter(py_features);
+    if (!py_iter)
         return NULL;
 
-    PyObject *py_list = PyList_New(0);
-
-    uint32_t num_devices;
-    vkEnumeratePhysicalDevices(vulkan_instance, &num_devices, nullptr);
-
-    std::vector<VkPhysicalDevice> devices(num_devices);
-    vkEnumeratePhysicalDevices(vulkan_instance, &num_devices, devices.data());
-
-    for (auto device : devices)
+    uint64_t mask = 0;
+    while (PyObject *py_item = PyIter_Next(py_iter))
     {
-        VkPhysicalDeviceProperties prop;
-        vkGetPhysicalDeviceProperties(device, &prop);
-
-        vulkan_Device *py_device = (vulkan_Device *)PyObject_New(vulkan_Device, &vulkan_Device_Type);
-        if (!py_device)
+        const char *name = PyUnicode_AsUTF8(py_item);
+        if (!name)
         {
-            Py_DECREF(py_list);
-            return PyErr_Format(PyExc_MemoryError, "unable to allocate vulkan Device");
+            Py_DECREF(py_item);
+            Py_DECREF(py_iter);
+            return NULL;
         }
-        COMPUSHADY_CLEAR(py_device);
-
-        py_device->physical_device = device;
-        py_device->name = PyUnicode_FromString(prop.deviceName);
-        vkGetPhysicalDeviceMemoryProperties(device, &py_device->mem_props);
 
-        for (uint64_t i = 0; i < py_device->mem_props.memoryHeapCount; i++)
+        uint32_t feature = 0;
+        for (; feature < VULKAN_FEATURE_MAX; feature++)
         {
-            if (py_device->mem_props.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
-            {
-                py_device->dedicated_video_memory += py_device->mem_props.memoryHeaps[i].size;
-            }
-            else
-            {
-                py_device->shared_system_memory += py_device->mem_props.memoryHeaps[i].size;
-            }
+            if (!strcmp(name, vulkan_feature_names[feature]))
+                break;
         }
-        py_device->vendor_id = prop.vendorID;
-        py_device->device_id = prop.deviceID;
-        py_device->is_hardware = prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU || prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU || prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU;
-        py_device->is_discrete = prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
-        PyList_Append(py_list, (PyObject *)py_device);
-        Py_DECREF(py_device);
-    }
 
-    return py_list;
-}
+        if (feature >= VULKAN_FEATURE_MAX)
+        {
+            PyErr_Format(PyExc_ValueError, "unknown feature: %s", name);
+            Py_DECREF(py_item);
+            Py_DECREF(py_iter);
+            return NULL;
+        }
 
-static PyMemberDef vulkan_Resource_members[] = {
-    {"size", T_ULONGLONG, offsetof(vulkan_Resource, size), 0, "resource size"},
-    {"width", T_UINT, offsetof(vulkan_Resource, image_extent) + offsetof(VkExtent3D, width), 0,
-     "resource width"},
-    {"height", T_UINT, offsetof(vulkan_Resource, image_extent) + offsetof(VkExtent3D, height), 0,
-     "resource height"},
-    {"depth", T_UINT, offsetof(vulkan_Resource, image_extent) + offsetof(VkExtent3D, depth), 0,
-     "resource depth"},
-    {"row_pitch", T_ULONGLONG, offsetof(vulkan_Resource, row_pitch), 0, "resource row pitch"},
-    {"slices", T_UINT, offsetof(vulkan_Resource, slices), 0, "resource number of slices"},
-    {"heap_size", T_ULONGLONG, offsetof(vulkan_Resource, heap_size), 0, "resource heap size"},
-    {"heap_type", T_INT, offsetof(vulkan_Resource, heap_type), 0, "resource heap type"},
-    {"tiles_x", T_UINT, offsetof(vulkan_Resource, tiles_x), 0, "sparsed resource number of tiles on x axis"},
-    {"tiles_y", T_UINT, offsetof(vulkan_Resource, tiles_y), 0, "sparsed resource number of tiles on y axis"},
-    {"tiles_z", T_UINT, offsetof(vulkan_Resource, tiles_z), 0, "sparsed resource number of tiles on z axis"},
-    {"tile_width", T_UINT, offsetof(vulkan_Resource, tile_width), 0, "sparsed resource tile width"},
-    {"tile_height", T_UINT, offsetof(vulkan_Resource, tile_height), 0, "sparsed resource tile height"},
-    {"tile_depth", T_UINT, offsetof(vulkan_Resource, tile_depth), 0, "sparsed resource tile depth"},
-    {NULL} /* Sentinel */
-};
+        if (request && !(self->supported_features & (1ULL << feature)))
+        {
+            PyErr_Format(PyExc_ValueError, "feature %s is not supported by the device", name);
+            Py_DECREF(py_item);
+            Py_DECREF(py_iter);
+            return NULL;
+        }
 
-static PyMemberDef vulkan_Swapchain_members[] = {
-    {"width", T_UINT, offsetof(vulkan_Swapchain, image_extent) + offsetof(VkExtent2D, width), 0,
-     "swapchain width"},
-    {"height", T_UINT, offsetof(vulkan_Swapchain, image_extent) + offsetof(VkExtent2D, height), 0,
-     "swapchain height"},
-    {NULL} /* Sentinel */
-};
+        Py_DECREF(py_item);
+        mask |= 1ULL << feature;
+    }
+    Py_DECREF(py_iter);
 
-static PyObject *vulkan_Resource_upload(vulkan_Resource *self, PyObject *args)
-{
-    Py_buffer view;
-    uint64_t offset = 0;
-    if (!PyArg_ParseTuple(args, "y*K", &view, &offset))
+    if (PyErr_Occurred())
         return NULL;
 
-    if ((uint64_t)offset + view.len > self->size)
+    if (request)
     {
-        uint64_t size = view.len;
-        PyBuffer_Release(&view);
-        return PyErr_Format(PyExc_ValueError,
-                            "supplied buffer is bigger than resource size: (offset "
-                            "%llu) %llu (expected no more than %llu)",
-                            offset, size, self->size);
+        self->requested_features |= mask;
+        self->disabled_features &= ~mask;
     }
-
-    char *mapped_data;
-    VkResult result = vkMapMemory(
-        self->py_device->device, self->memory, self->heap_offset, self->size, 0, (void **)&mapped_data);
-    if (result != VK_SUCCESS)
+    else
     {
-        PyBuffer_Release(&view);
-        return PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        self->disabled_features |= mask;
+        self->requested_features &= ~mask;
     }
 
-    memcpy(mapped_data + offset, view.buf, view.len);
-    vkUnmapMemory(self->py_device->device, self->memory);
-    PyBuffer_Release(&view);
-
     Py_RETURN_NONE;
 }
 
-static PyObject *vulkan_Resource_upload2d(vulkan_Resource *self, PyObject *args)
+static PyObject *vulkan_Device_request_features(vulkan_Device *self, PyObject *args)
 {
-    Py_buffer view;
-    uint32_t pitch;
-    uint32_t width;
-    uint32_t height;
-    uint32_t bytes_per_pixel;
-    if (!PyArg_ParseTuple(args, "y*IIII", &view, &pitch, &width, &height, &bytes_per_pixel))
-        return NULL;
+    return vulkan_Device_change_features(self, args, true);
+}
 
-    char *mapped_data;
-    VkResult result = vkMapMemory(
-        self->py_device->device, self->memory, self->heap_offset, self->size, 0, (void **)&mapped_data);
-    if (result != VK_SUCCESS)
+static PyObject *vulkan_Device_disable_features(vulkan_Device *self, PyObject *args)
+{
+    return vulkan_Device_change_features(self, args, false);
+}
+
+static PyObject *vulkan_Device_get_debug_messages(vulkan_Device *self, PyObject *args)
+{
+    PyObject *py_list = PyList_New(0);
+
+    for (const std::string &message : vulkan_debug_messages)
     {
-        PyBuffer_Release(&view);
-        return PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        PyList_Append(py_list, PyUnicode_FromString(message.c_str()));
     }
+    vulkan_debug_messages = {};
 
-    uint64_t offset = 0;
-    uint64_t remains = view.len;
-    uint64_t resource_remains = self->size;
-    for (uint32_t y = 0; y < height; y++)
+    return py_list;
+}
+
+static PyObject *vulkan_Device_empty_cache(vulkan_Device *self, PyObject *args)
+{
+    vulkan_Device_release_buffer_cache(self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Device_collect_completed(vulkan_Device *self, PyObject *args)
+{
+    if (self->device)
     {
-        uint64_t amount = Py_MIN(width * bytes_per_pixel, Py_MIN(remains, resource_remains));
-        memcpy(mapped_data + (pitch * y), (char *)view.buf + offset, amount);
-        remains -= amount;
-        if (remains == 0)
-            break;
-        resource_remains -= amount;
-        offset += amount;
+        vulkan_Device_collect(self);
     }
+    Py_RETURN_NONE;
+}
 
-    vkUnmapMemory(self->py_device->device, self->memory);
-    PyBuffer_Release(&view);
-
+static PyObject *vulkan_Device_wait_idle(vulkan_Device *self, PyObject *args)
+{
+    if (self->device)
+    {
+        vulkan_Device_wait(self);
+    }
     Py_RETURN_NONE;
 }
 
-static PyObject *vulkan_Resource_upload_chunked(vulkan_Resource *self, PyObject *args)
+static PyObject *vulkan_Resource_copy_to(vulkan_Resource *self, COMPUSHADY_FASTCALL_ARGS);
+static PyObject *vulkan_Compute_dispatch(vulkan_Compute *self, COMPUSHADY_FASTCALL_ARGS);
+static PyObject *vulkan_Compute_dispatch_many(vulkan_Compute *self, PyObject *args);
+static PyObject *vulkan_Compute_dispatch_indirect(vulkan_Compute *self, PyObject *args);
+static PyObject *vulkan_Compute_dispatch_indirect_many(vulkan_Compute *self, PyObject *args);
+
+/*
+ * Returns the Device of a Resource.copy_to() or Compute.dispatch*() bound method, NULL for any other callable.
+ */
+static vulkan_Device *vulkan_Device_get_batch_device(PyObject *py_method)
 {
-    Py_buffer view;
-    uint32_t stride;
-    Py_buffer filler;
-    if (!PyArg_ParseTuple(args, "y*Iy*", &view, &stride, &filler))
+    if (!PyCFunction_Check(py_method))
+    {
         return NULL;
+    }
 
-    uint64_t elements = view.len / stride;
-    uint64_t additional_bytes = elements * filler.len;
-
-    if (view.len + additional_bytes > self->size)
+    PyCFunction function = PyCFunction_GET_FUNCTION(py_method);
+    PyObject *py_self = PyCFunction_GET_SELF(py_method);
+    if (!py_self)
     {
-        PyBuffer_Release(&view);
-        PyBuffer_Release(&filler);
-        return PyErr_Format(PyExc_ValueError,
-                            "supplied buffer is bigger than resource size: %llu "
-                            "(expected no more than %llu)",
-                            view.len + additional_bytes, self->size);
+        return NULL;
     }
 
-    char *mapped_data;
-    VkResult result = vkMapMemory(
-        self->py_device->device, self->memory, self->heap_offset, self->size, 0, (void **)&mapped_data);
-    if (result != VK_SUCCESS)
+    if (function == (PyCFunction)(void (*)(void))vulkan_Resource_copy_to)
     {
-        PyBuffer_Release(&view);
-        PyBuffer_Release(&filler);
-        return PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        return ((vulkan_Resource *)py_self)->py_device;
     }
 
-    uint64_t offset = 0;
-    for (uint32_t i = 0; i < elements; i++)
+    if (function == (PyCFunction)(void (*)(void))vulkan_Compute_dispatch ||
+        function == (PyCFunction)vulkan_Compute_dispatch_many ||
+        function == (PyCFunction)vulkan_Compute_dispatch_indirect ||
+        function == (PyCFunction)vulkan_Compute_dispatch_indirect_many)
     {
-        memcpy(mapped_data + offset, (char *)view.buf + (i * stride), stride);
-        offset += stride;
-        memcpy(mapped_data + offset, (char *)filler.buf, filler.len);
-        offset += filler.len;
+        return ((vulkan_Compute *)py_self)->py_device;
     }
 
-    vkUnmapMemory(self->py_device->device, self->memory);
-    PyBuffer_Release(&view);
-    PyBuffer_Release(&filler);
-    Py_RETURN_NONE;
+    return NULL;
 }
 
-static PyObject *vulkan_Resource_readback(vulkan_Resource *self, PyObject *args)
+/*
+ * Records a sequence of (method, arguments) commands in a single command buffer submitted once at the end.
+ * The GIL is held while recording, so the commands of other threads cannot end in the batch.
+ * If a command fails, the ones recorded before it are still executed (and waited for).
+ */
+static PyObject *vulkan_Device_submit_batch(vulkan_Device *self, PyObject *args)
 {
-    uint64_t size;
-    uint64_t offset;
-    if (!PyArg_ParseTuple(args, "KK", &size, &offset))
+    PyObject *py_commands;
+    int wait = 1;
+    if (!PyArg_ParseTuple(args, "O|p", &py_commands, &wait))
         return NULL;
 
-    if (size == 0)
-        size = self->size - offset;
+    PyObject *py_sequence = PySequence_Fast(py_commands, "commands must be a sequence");
+    if (!py_sequence)
+    {
+        return NULL;
+    }
 
-    if (offset + size > self->size)
+    const Py_ssize_t commands = PySequence_Fast_GET_SIZE(py_sequence);
+    for (Py_ssize_t i = 0; i < commands; i++)
     {
-        return PyErr_Format(PyExc_ValueError,
-                            "requested buffer out of bounds: (offset %llu) %llu "
-                            "(expected no more than %llu)",
-                            offset, size, self->size);
+        PyObject *py_command = PySequence_Fast_GET_ITEM(py_sequence, i);
+        if (!PyTuple_Check(py_command) || PyTuple_GET_SIZE(py_command) != 2 || !PyTuple_Check(PyTuple_GET_ITEM(py_command, 1)))
+        {
+            Py_DECREF(py_sequence);
+            return PyErr_Format(PyExc_ValueError, "commands must be (method, arguments tuple) pairs");
+        }
+
+        if (vulkan_Device_get_batch_device(PyTuple_GET_ITEM(py_command, 0)) != self)
+        {
+            Py_DECREF(py_sequence);
+            return PyErr_Format(PyExc_ValueError, "command %zd is not a copy_to() or dispatch method of this Device", i);
+        }
     }
 
-    char *mapped_data;
-    VkResult result = vkMapMemory(
-        self->py_device->device, self->memory, self->heap_offset, self->size, 0, (void **)&mapped_data);
-    if (result != VK_SUCCESS)
+    if (commands == 0)
     {
-        return PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        Py_DECREF(py_sequence);
+        return PyLong_FromUnsignedLongLong(self->submitted_serial);
     }
 
-    PyObject *py_bytes = PyBytes_FromStringAndSize(mapped_data + offset, size);
-    vkUnmapMemory(self->py_device->device, self->memory);
-    return py_bytes;
-}
+    vulkan_Device_begin(self);
+    self->recording_batch = true;
 
-static PyObject *vulkan_Resource_readback_to_buffer(vulkan_Resource *self, PyObject *args)
-{
-    Py_buffer view;
-    uint64_t offset = 0;
-    if (!PyArg_ParseTuple(args, "y*K", &view, &offset))
-        return NULL;
+    bool success = true;
+    for (Py_ssize_t i = 0; i < commands; i++)
+    {
+        PyObject *py_command = PySequence_Fast_GET_ITEM(py_sequence, i);
+        PyObject *py_result = PyObject_Call(PyTuple_GET_ITEM(py_command, 0), PyTuple_GET_ITEM(py_command, 1), NULL);
+        if (!py_result)
+        {
+            success = false;
+            break;
+        }
+        Py_DECREF(py_result);
+    }
 
-    if (offset > self->size)
+    self->recording_batch = false;
+    Py_DECREF(py_sequence);
+
+    // the recorded commands can include the pending layout transitions, so they cannot be discarded
+    VkResult result = (wait || !success) ? vulkan_Device_submit_and_wait(self) : vulkan_Device_submit(self, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+    if (!success)
     {
-        PyBuffer_Release(&view);
-        return PyErr_Format(PyExc_ValueError,
-                            "requested buffer out of bounds: %llu (expected no more than %llu)", offset,
-                            self->size);
+        return NULL;
     }
 
-    char *mapped_data;
-    VkResult result = vkMapMemory(
-        self->py_device->device, self->memory, self->heap_offset, self->size, 0, (void **)&mapped_data);
     if (result != VK_SUCCESS)
     {
-        PyBuffer_Release(&view);
-        return PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
     }
 
-    memcpy(view.buf, mapped_data + offset, Py_MIN((uint64_t)view.len, self->size - offset));
-
-    vkUnmapMemory(self->py_device->device, self->memory);
-
-    PyBuffer_Release(&view);
-    Py_RETURN_NONE;
+    return PyLong_FromUnsignedLongLong(self->submitted_serial);
 }
 
-static PyObject *vulkan_Resource_readback2d(vulkan_Resource *self, PyObject *args)
+/*
+ * Waits (with the GIL released) for the fence of a submission, the previous ones are completed too.
+ */
+static PyObject *vulkan_Device_wait_for(vulkan_Device *self, PyObject *args)
 {
-    uint32_t pitch;
-    uint32_t width;
-    uint32_t height;
-    uint32_t bytes_per_pixel;
-    if (!PyArg_ParseTuple(args, "IIII", &pitch, &width, &height, &bytes_per_pixel))
+    unsigned long long serial;
+    if (!PyArg_ParseTuple(args, "K", &serial))
         return NULL;
 
-    if (compushady_get_size_by_pitch(pitch, width, height, 1, bytes_per_pixel) > self->size)
+    if (serial > self->submitted_serial)
     {
-        return PyErr_Format(PyExc_ValueError,
-                            "requested buffer out of bounds: %llu (expected no more than %llu)", pitch * height,
-                            self->size);
+        return PyErr_Format(PyExc_ValueError, "serial %llu has not been submitted (last submitted: %llu)", serial, (unsigned long long)self->submitted_serial);
     }
 
-    char *mapped_data;
-    VkResult result = vkMapMemory(
-        self->py_device->device, self->memory, self->heap_offset, self->size, 0, (void **)&mapped_data);
-    if (result != VK_SUCCESS)
+    if (!self->device)
     {
-        return PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        Py_RETURN_NONE;
     }
 
-    char *data2d = (char *)PyMem_Malloc(width * height * bytes_per_pixel);
-    if (!data2d)
+    vulkan_Device_poll(self);
+    if (self->completed_serial < serial)
     {
-        vkUnmapMemory(self->py_device->device, self->memory);
-        return PyErr_Format(PyExc_MemoryError, "Unable to allocate memory for 2d data");
-    }
+        VkFence fence = VK_NULL_HANDLE;
+        if (self->submissions)
+        {
+            for (const vulkan_Submission &submission : *self->submissions)
+            {
+                if (submission.serial == serial)
+                {
+                    fence = submission.fence;
+                    break;
+                }
+            }
+        }
 
-    for (uint32_t y = 0; y < height; y++)
-    {
-        memcpy(data2d + (width * bytes_per_pixel * y), mapped_data + (pitch * y),
-               width * bytes_per_pixel);
+        // the submissions without a fence have been already waited for
+        if (fence)
+        {
+            Py_BEGIN_ALLOW_THREADS;
+            vkWaitForFences(self->device, 1, &fence, VK_TRUE, UINT64_MAX);
+            Py_END_ALLOW_THREADS;
+        }
+        else
+        {
+            vulkan_Device_wait(self);
+        }
     }
 
-    PyObject *py_bytes = PyBytes_FromStringAndSize(data2d, width * height * bytes_per_pixel);
-
-    PyMem_Free(data2d);
-    vkUnmapMemory(self->py_device->device, self->memory);
-    return py_bytes;
+    vulkan_Device_collect(self);
+    Py_RETURN_NONE;
 }
 
-static PyObject *vulkan_Resource_copy_to(vulkan_Resource *self, PyObject *args)
+static PyMethodDef vulkan_Device_methods[] = {
+    {"create_buffer", (PyCFunction)vulkan_Device_create_buffer, METH_VARARGS,
+     "Creates a Buffer object"},
+    {"create_texture1d", (PyCFunction)vulkan_Device_create_texture1d, METH_VARARGS,
+     "Creates a Texture1D object"},
+    {"create_texture2d", (PyCFunction)vulkan_Device_create_texture2d, METH_VARARGS,
+     "Creates a Texture2D object"},
+    {"create_texture3d", (PyCFunction)vulkan_Device_create_texture3d, METH_VARARGS,
+     "Creates a Texture3D object"},
+    {"get_debug_messages", (PyCFunction)vulkan_Device_get_debug_messages, METH_VARARGS,
+     "Get Device's debug messages"},
+    {"create_compute", (PyCFunction)vulkan_Device_create_compute, METH_VARARGS | METH_KEYWORDS,
+     "Creates a Compute object"},
+    {"create_swapchain", (PyCFunction)vulkan_Device_create_swapchain, METH_VARARGS,
+     "Creates a Swapchain object"},
+    {"create_sampler", (PyCFunction)vulkan_Device_create_sampler, METH_VARARGS,
+     "Creates a Sampler object"},
+    {"create_heap", (PyCFunction)vulkan_Device_create_heap, METH_VARARGS,
+     "Creates a Heap object"},
+    {"request_features", (PyCFunction)vulkan_Device_request_features, METH_VARARGS,
+     "Requests optional features to be enabled at device initialization"},
+    {"disable_features", (PyCFunction)vulkan_Device_disable_features, METH_VARARGS,
+     "Requests optional features to be disabled at device initialization"},
+    {"empty_cache", (PyCFunction)vulkan_Device_empty_cache, METH_NOARGS,
+     "Releases the memory of the recycled Buffers"},
+    {"collect", (PyCFunction)vulkan_Device_collect_completed, METH_NOARGS,
+     "Checks the fences of the submissions in flight and destroys the objects released while they were running"},
+    {"wait", (PyCFunction)vulkan_Device_wait_idle, METH_NOARGS,
+     "Waits for all of the submissions in flight"},
+    {"submit_batch", (PyCFunction)vulkan_Device_submit_batch, METH_VARARGS,
+     "Records copy_to() and dispatch calls in a single submission and returns its serial"},
+    {"wait_for", (PyCFunction)vulkan_Device_wait_for, METH_VARARGS,
+     "Waits for the submission with the specified serial"},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+static PyObject *vulkan_get_discovered_devices(PyObject *self)
 {
-    PyObject *py_destination;
-    uint64_t size;
-    uint64_t src_offset;
-    uint64_t dst_offset;
-    uint32_t width;
-    uint32_t height;
-    uint32_t depth;
-    uint32_t src_x;
-    uint32_t src_y;
-    uint32_t src_z;
-    uint32_t dst_x;
-    uint32_t dst_y;
-    uint32_t dst_z;
-    uint32_t src_slice;
-    uint32_t dst_slice;
-    if (!PyArg_ParseTuple(args, "OKKKIIIIIIIIIII", &py_destination, &size, &src_offset, &dst_offset, &width, &height, &depth, &src_x, &src_y, &src_z, &dst_x, &dst_y, &dst_z, &src_slice, &dst_slice))
+    if (!vulkan_instance_check())
         return NULL;
 
-    int ret = PyObject_IsInstance(py_destination, (PyObject *)&vulkan_Resource_Type);
-    if (ret < 0)
-    {
-        return NULL;
-    }
-    else if (ret == 0)
-    {
-        return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
-    }
+    PyObject *py_list = PyList_New(0);
 
-    vulkan_Resource *dst_resource = (vulkan_Resource *)py_destination;
+    uint32_t num_devices;
+    vkEnumeratePhysicalDevices(vulkan_instance, &num_devices, nullptr);
 
-    if (size == 0)
-    {
-        size = self->size;
-    }
+    std::vector<VkPhysicalDevice> devices(num_devices);
+    vkEnumeratePhysicalDevices(vulkan_instance, &num_devices, devices.data());
 
-    if (!compushady_check_copy_to(self->buffer,
-                                  dst_resource->buffer, size, src_offset, dst_offset, self->size, dst_resource->size,
-                                  src_x, src_y, src_z, src_slice, self->slices, dst_slice, dst_resource->slices,
-                                  self->image_extent.width, self->image_extent.height, self->image_extent.depth,
-                                  dst_resource->image_extent.width, dst_resource->image_extent.height, dst_resource->image_extent.depth,
-                                  &dst_x, &dst_y, &dst_z, &width, &height, &depth))
+    for (auto device : devices)
     {
-        return NULL;
-    }
+        VkPhysicalDeviceProperties prop;
+        vkGetPhysicalDeviceProperties(device, &prop);
 
-    VkCommandBufferBeginInfo begin_info = {};
-    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vulkan_Device *py_device = (vulkan_Device *)PyObject_New(vulkan_Device, &vulkan_Device_Type);
+        if (!py_device)
+        {
+            Py_DECREF(py_list);
+            return PyErr_Format(PyExc_MemoryError, "unable to allocate vulkan Device");
+        }
+        COMPUSHADY_CLEAR(py_device);
 
-    vkBeginCommandBuffer(self->py_device->command_buffer, &begin_info);
-    if (self->buffer && dst_resource->buffer)
-    {
-        VkBufferCopy buffer_copy = {};
-        buffer_copy.srcOffset = src_offset;
-        buffer_copy.dstOffset = dst_offset;
-        buffer_copy.size = size;
-        vkCmdCopyBuffer(
-            self->py_device->command_buffer, self->buffer, dst_resource->buffer, 1, &buffer_copy);
-    }
-    else if (self->buffer) // buffer to image
-    {
-        VkImageMemoryBarrier image_memory_barrier = {};
-        image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        image_memory_barrier.image = dst_resource->image;
-        image_memory_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        image_memory_barrier.subresourceRange.levelCount = 1;
-        image_memory_barrier.subresourceRange.baseArrayLayer = dst_slice;
-        image_memory_barrier.subresourceRange.layerCount = 1;
-        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        py_device->physical_device = device;
+        py_device->name = PyUnicode_FromString(prop.deviceName);
+        vkGetPhysicalDeviceMemoryProperties(device, &py_device->mem_props);
 
-        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        for (uint64_t i = 0; i < py_device->mem_props.memoryHeapCount; i++)
+        {
+            if (py_device->mem_props.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            {
+                py_device->dedicated_video_memory += py_device->mem_props.memoryHeaps[i].size;
+            }
+            else
+            {
+                py_device->shared_system_memory += py_device->mem_props.memoryHeaps[i].size;
+            }
+        }
+        py_device->vendor_id = prop.vendorID;
+        py_device->device_id = prop.deviceID;
+        py_device->is_hardware = prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU || prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU || prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU;
+        py_device->is_discrete = prop.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+        py_device->supported_features = vulkan_get_supported_features(device);
+        py_device->max_uniform_buffer_range = prop.limits.maxUniformBufferRange;
+        py_device->min_uniform_buffer_offset_alignment = (uint32_t)prop.limits.minUniformBufferOffsetAlignment;
+        py_device->min_storage_buffer_offset_alignment = (uint32_t)prop.limits.minStorageBufferOffsetAlignment;
+        py_device->min_texel_buffer_offset_alignment = (uint32_t)prop.limits.minTexelBufferOffsetAlignment;
+        if (!vulkan_Device_get_compute_properties(py_device, prop.limits))
+        {
+            Py_DECREF(py_device);
+            Py_DECREF(py_list);
+            return NULL;
+        }
+        py_device->py_features = PyDict_New();
+        if (!py_device->py_features)
+        {
+            Py_DECREF(py_device);
+            Py_DECREF(py_list);
+            return NULL;
+        }
+        for (uint32_t i = 0; i < VULKAN_FEATURE_MAX; i++)
+        {
+            if (PyDict_SetItemString(py_device->py_features, vulkan_feature_names[i], (py_device->supported_features & (1ULL << i)) ? Py_True : Py_False) < 0)
+            {
+                Py_DECREF(py_device);
+                Py_DECREF(py_list);
+                return NULL;
+            }
+        }
+        PyList_Append(py_list, (PyObject *)py_device);
+        Py_DECREF(py_device);
+    }
+
+    return py_list;
+}
+
+static PyMemberDef vulkan_Resource_members[] = {
+    {"size", T_ULONGLONG, offsetof(vulkan_Resource, size), 0, "resource size"},
+    {"width", T_UINT, offsetof(vulkan_Resource, image_extent) + offsetof(VkExtent3D, width), 0,
+     "resource width"},
+    {"height", T_UINT, offsetof(vulkan_Resource, image_extent) + offsetof(VkExtent3D, height), 0,
+     "resource height"},
+    {"depth", T_UINT, offsetof(vulkan_Resource, image_extent) + offsetof(VkExtent3D, depth), 0,
+     "resource depth"},
+    {"row_pitch", T_ULONGLONG, offsetof(vulkan_Resource, row_pitch), 0, "resource row pitch"},
+    {"slices", T_UINT, offsetof(vulkan_Resource, slices), 0, "resource number of slices"},
+    {"heap_size", T_ULONGLONG, offsetof(vulkan_Resource, heap_size), 0, "resource heap size"},
+    {"heap_type", T_INT, offsetof(vulkan_Resource, heap_type), 0, "resource heap type"},
+    {"tiles_x", T_UINT, offsetof(vulkan_Resource, tiles_x), 0, "sparsed resource number of tiles on x axis"},
+    {"tiles_y", T_UINT, offsetof(vulkan_Resource, tiles_y), 0, "sparsed resource number of tiles on y axis"},
+    {"tiles_z", T_UINT, offsetof(vulkan_Resource, tiles_z), 0, "sparsed resource number of tiles on z axis"},
+    {"tile_width", T_UINT, offsetof(vulkan_Resource, tile_width), 0, "sparsed resource tile width"},
+    {"tile_height", T_UINT, offsetof(vulkan_Resource, tile_height), 0, "sparsed resource tile height"},
+    {"tile_depth", T_UINT, offsetof(vulkan_Resource, tile_depth), 0, "sparsed resource tile depth"},
+    {"mips", T_UINT, offsetof(vulkan_Resource, mips), 0, "resource number of mips"},
+    {"mip_level", T_UINT, offsetof(vulkan_Resource, mip), 0, "resource mip level (for mip views)"},
+    {"device_address", T_ULONGLONG, offsetof(vulkan_Resource, device_address), 0, "buffer GPU virtual address (0 if not supported)"},
+    {"usage", T_UINT, offsetof(vulkan_Resource, usage), 0, "resource usage flags"},
+    {NULL} /* Sentinel */
+};
+
+static PyMemberDef vulkan_Swapchain_members[] = {
+    {"width", T_UINT, offsetof(vulkan_Swapchain, image_extent) + offsetof(VkExtent2D, width), 0,
+     "swapchain width"},
+    {"height", T_UINT, offsetof(vulkan_Swapchain, image_extent) + offsetof(VkExtent2D, height), 0,
+     "swapchain height"},
+    {NULL} /* Sentinel */
+};
+
+/*
+ * Maps the whole memory of the resource (or returns the existing mapping) and returns its range, NULL on error.
+ * A VkDeviceMemory cannot be mapped twice, and the file transfers keep it mapped with the GIL released
+ * (so another thread could map it again, even for another Buffer of the same Heap): the mapping is shared
+ * and unmapped when the last user releases it. Must be called with the GIL held.
+ */
+static char *vulkan_Resource_map(vulkan_Resource *self)
+{
+    vulkan_Device *py_device = self->py_device;
+    if (!py_device->mappings)
+    {
+        py_device->mappings = new std::unordered_map<VkDeviceMemory, vulkan_Mapping>();
+    }
+
+    auto mapping = py_device->mappings->find(self->memory);
+    if (mapping != py_device->mappings->end())
+    {
+        mapping->second.references++;
+        return mapping->second.data + self->heap_offset;
+    }
+
+    char *mapped_data;
+    VkResult result = vkMapMemory(py_device->device, self->memory, 0, VK_WHOLE_SIZE, 0, (void **)&mapped_data);
+    if (result != VK_SUCCESS)
+    {
+        PyErr_Format(PyExc_Exception, "Unable to Map VkDeviceMemory");
+        return NULL;
+    }
+
+    (*py_device->mappings)[self->memory] = {mapped_data, 1};
+    return mapped_data + self->heap_offset;
+}
+
+static void vulkan_Resource_unmap(vulkan_Resource *self)
+{
+    vulkan_Device *py_device = self->py_device;
+    auto mapping = py_device->mappings->find(self->memory);
+    if (--mapping->second.references == 0)
+    {
+        vkUnmapMemory(py_device->device, self->memory);
+        py_device->mappings->erase(mapping);
+    }
+}
+
+static PyObject *vulkan_Resource_upload(vulkan_Resource *self, COMPUSHADY_FASTCALL_ARGS)
+{
+    static const char *kwlist[] = {"data", "offset", NULL};
+    PyObject *slots[2];
+    Py_buffer view = {};
+    uint64_t offset = 0;
+    if (!compushady_fastcall_parse("upload", kwlist, 1, slots, COMPUSHADY_FASTCALL_PASS) ||
+        !compushady_fastcall_uint64(slots[1], &offset) ||
+        !compushady_fastcall_buffer(slots[0], &view))
+        return NULL;
+
+    if (offset > self->size || (uint64_t)view.len > self->size - offset)
+    {
+        uint64_t size = view.len;
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError,
+                            "supplied buffer is bigger than resource size: (offset "
+                            "%llu) %llu (expected no more than %llu)",
+                            offset, size, self->size);
+    }
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    memcpy(mapped_data + offset, view.buf, view.len);
+    vulkan_Resource_unmap(self);
+    PyBuffer_Release(&view);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Resource_upload2d(vulkan_Resource *self, PyObject *args)
+{
+    Py_buffer view;
+    uint32_t pitch;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytes_per_pixel;
+    if (!PyArg_ParseTuple(args, "y*IIII", &view, &pitch, &width, &height, &bytes_per_pixel))
+        return NULL;
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    uint64_t offset = 0;
+    uint64_t remains = view.len;
+    uint64_t resource_remains = self->size;
+    for (uint32_t y = 0; y < height; y++)
+    {
+        uint64_t amount = Py_MIN(width * bytes_per_pixel, Py_MIN(remains, resource_remains));
+        memcpy(mapped_data + (pitch * y), (char *)view.buf + offset, amount);
+        remains -= amount;
+        if (remains == 0)
+            break;
+        resource_remains -= amount;
+        offset += amount;
+    }
+
+    vulkan_Resource_unmap(self);
+    PyBuffer_Release(&view);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Resource_upload_chunked(vulkan_Resource *self, PyObject *args)
+{
+    Py_buffer view;
+    uint32_t stride;
+    Py_buffer filler;
+    if (!PyArg_ParseTuple(args, "y*Iy*", &view, &stride, &filler))
+        return NULL;
+
+    uint64_t elements = view.len / stride;
+    uint64_t additional_bytes = elements * filler.len;
+
+    if (view.len + additional_bytes > self->size)
+    {
+        PyBuffer_Release(&view);
+        PyBuffer_Release(&filler);
+        return PyErr_Format(PyExc_ValueError,
+                            "supplied buffer is bigger than resource size: %llu "
+                            "(expected no more than %llu)",
+                            view.len + additional_bytes, self->size);
+    }
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        PyBuffer_Release(&view);
+        PyBuffer_Release(&filler);
+        return NULL;
+    }
+
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < elements; i++)
+    {
+        memcpy(mapped_data + offset, (char *)view.buf + (i * stride), stride);
+        offset += stride;
+        memcpy(mapped_data + offset, (char *)filler.buf, filler.len);
+        offset += filler.len;
+    }
+
+    vulkan_Resource_unmap(self);
+    PyBuffer_Release(&view);
+    PyBuffer_Release(&filler);
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Resource_readback_into(vulkan_Resource *self, Py_buffer *view, const uint64_t offset)
+{
+    if (offset > self->size)
+    {
+        return PyErr_Format(PyExc_ValueError,
+                            "requested buffer out of bounds: %llu (expected no more than %llu)", offset,
+                            self->size);
+    }
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        return NULL;
+    }
+
+    memcpy(view->buf, mapped_data + offset, Py_MIN((uint64_t)view->len, self->size - offset));
+
+    vulkan_Resource_unmap(self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Resource_readback(vulkan_Resource *self, COMPUSHADY_FASTCALL_ARGS)
+{
+    static const char *kwlist[] = {"buffer_or_size", "offset", NULL};
+    PyObject *slots[2];
+    uint64_t size = 0;
+    uint64_t offset = 0;
+    if (!compushady_fastcall_parse("readback", kwlist, 0, slots, COMPUSHADY_FASTCALL_PASS) ||
+        !compushady_fastcall_uint64(slots[1], &offset))
+        return NULL;
+
+    // a writable buffer object in place of the size behaves like readback_to_buffer
+    if (slots[0] && !PyLong_Check(slots[0]) && PyObject_CheckBuffer(slots[0]))
+    {
+        Py_buffer view;
+        if (PyObject_GetBuffer(slots[0], &view, PyBUF_WRITABLE) < 0)
+            return NULL;
+        PyObject *py_ret = vulkan_Resource_readback_into(self, &view, offset);
+        PyBuffer_Release(&view);
+        return py_ret;
+    }
+
+    if (!compushady_fastcall_uint64(slots[0], &size))
+        return NULL;
+
+    if (offset > self->size)
+    {
+        return PyErr_Format(PyExc_ValueError,
+                            "requested buffer out of bounds: %llu (expected no more than %llu)", offset,
+                            self->size);
+    }
+
+    if (size == 0)
+        size = self->size - offset;
+
+    if (size > self->size - offset)
+    {
+        return PyErr_Format(PyExc_ValueError,
+                            "requested buffer out of bounds: (offset %llu) %llu "
+                            "(expected no more than %llu)",
+                            offset, size, self->size);
+    }
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        return NULL;
+    }
+
+    PyObject *py_bytes = PyBytes_FromStringAndSize(mapped_data + offset, size);
+    vulkan_Resource_unmap(self);
+    return py_bytes;
+}
+
+static PyObject *vulkan_Resource_readback_to_buffer(vulkan_Resource *self, PyObject *args)
+{
+    Py_buffer view;
+    uint64_t offset = 0;
+    if (!PyArg_ParseTuple(args, "y*K", &view, &offset))
+        return NULL;
+
+    PyObject *py_ret = vulkan_Resource_readback_into(self, &view, offset);
+    PyBuffer_Release(&view);
+    return py_ret;
+}
+
+/*
+ * Transfers data between a file descriptor and the mapped memory of the resource without intermediate copies,
+ * the GIL is released while the (multithreaded) file I/O is running.
+ */
+static PyObject *vulkan_Resource_file_transfer(vulkan_Resource *self, PyObject *args, const bool to_file)
+{
+    int fd;
+    uint64_t file_offset;
+    uint64_t size;
+    uint64_t offset;
+    if (!PyArg_ParseTuple(args, "iKKK", &fd, &file_offset, &size, &offset))
+        return NULL;
+
+    // offset + size could wrap around
+    if (offset > self->size || size > self->size - offset)
+    {
+        return PyErr_Format(PyExc_ValueError,
+                            "requested range out of bounds: (offset %llu) %llu (expected no more than %llu)",
+                            offset, size, self->size);
+    }
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        return NULL;
+    }
+
+    bool success;
+    Py_BEGIN_ALLOW_THREADS;
+    success = compushady_file_transfer(fd, mapped_data + offset, file_offset, size, to_file);
+    Py_END_ALLOW_THREADS;
+
+    vulkan_Resource_unmap(self);
+
+    if (!success)
+    {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Resource_upload_file(vulkan_Resource *self, PyObject *args)
+{
+    return vulkan_Resource_file_transfer(self, args, false);
+}
+
+static PyObject *vulkan_Resource_readback_to_file(vulkan_Resource *self, PyObject *args)
+{
+    return vulkan_Resource_file_transfer(self, args, true);
+}
+
+static PyObject *vulkan_Resource_readback2d(vulkan_Resource *self, PyObject *args)
+{
+    uint32_t pitch;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytes_per_pixel;
+    if (!PyArg_ParseTuple(args, "IIII", &pitch, &width, &height, &bytes_per_pixel))
+        return NULL;
+
+    if (compushady_get_size_by_pitch(pitch, width, height, 1, bytes_per_pixel) > self->size)
+    {
+        return PyErr_Format(PyExc_ValueError,
+                            "requested buffer out of bounds: %llu (expected no more than %llu)", pitch * height,
+                            self->size);
+    }
+
+    char *mapped_data = vulkan_Resource_map(self);
+    if (!mapped_data)
+    {
+        return NULL;
+    }
+
+    char *data2d = (char *)PyMem_Malloc(width * height * bytes_per_pixel);
+    if (!data2d)
+    {
+        vulkan_Resource_unmap(self);
+        return PyErr_Format(PyExc_MemoryError, "Unable to allocate memory for 2d data");
+    }
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        memcpy(data2d + (width * bytes_per_pixel * y), mapped_data + (pitch * y),
+               width * bytes_per_pixel);
+    }
+
+    PyObject *py_bytes = PyBytes_FromStringAndSize(data2d, width * height * bytes_per_pixel);
+
+    PyMem_Free(data2d);
+    vulkan_Resource_unmap(self);
+    return py_bytes;
+}
+
+static PyObject *vulkan_Resource_copy_to(vulkan_Resource *self, COMPUSHADY_FASTCALL_ARGS)
+{
+    static const char *kwlist[] = {"destination", "size", "src_offset", "dst_offset", "width", "height", "depth",
+                                   "src_x", "src_y", "src_z", "dst_x", "dst_y", "dst_z", "src_slice", "dst_slice",
+                                   "buffer_row_pitch", "buffer_slice_pitch", NULL};
+    PyObject *slots[17];
+    uint64_t size = 0;
+    uint64_t src_offset = 0;
+    uint64_t dst_offset = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t depth = 0;
+    uint32_t src_x = 0;
+    uint32_t src_y = 0;
+    uint32_t src_z = 0;
+    uint32_t dst_x = 0;
+    uint32_t dst_y = 0;
+    uint32_t dst_z = 0;
+    uint32_t src_slice = 0;
+    uint32_t dst_slice = 0;
+    uint64_t buffer_row_pitch = 0;
+    uint64_t buffer_slice_pitch = 0;
+    if (!compushady_fastcall_parse("copy_to", kwlist, 1, slots, COMPUSHADY_FASTCALL_PASS) ||
+        !compushady_fastcall_uint64(slots[1], &size) ||
+        !compushady_fastcall_uint64(slots[2], &src_offset) ||
+        !compushady_fastcall_uint64(slots[3], &dst_offset) ||
+        !compushady_fastcall_uint32(slots[4], &width) ||
+        !compushady_fastcall_uint32(slots[5], &height) ||
+        !compushady_fastcall_uint32(slots[6], &depth) ||
+        !compushady_fastcall_uint32(slots[7], &src_x) ||
+        !compushady_fastcall_uint32(slots[8], &src_y) ||
+        !compushady_fastcall_uint32(slots[9], &src_z) ||
+        !compushady_fastcall_uint32(slots[10], &dst_x) ||
+        !compushady_fastcall_uint32(slots[11], &dst_y) ||
+        !compushady_fastcall_uint32(slots[12], &dst_z) ||
+        !compushady_fastcall_uint32(slots[13], &src_slice) ||
+        !compushady_fastcall_uint32(slots[14], &dst_slice) ||
+        !compushady_fastcall_uint64(slots[15], &buffer_row_pitch) ||
+        !compushady_fastcall_uint64(slots[16], &buffer_slice_pitch))
+        return NULL;
+
+    PyObject *py_destination = slots[0];
+
+    int ret = PyObject_IsInstance(py_destination, (PyObject *)&vulkan_Resource_Type);
+    if (ret < 0)
+    {
+        return NULL;
+    }
+    else if (ret == 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
+    }
+
+    vulkan_Resource *dst_resource = (vulkan_Resource *)py_destination;
+
+    if (!(self->usage & COMPUSHADY_USAGE_TRANSFER) || !(dst_resource->usage & COMPUSHADY_USAGE_TRANSFER))
+    {
+        return PyErr_Format(PyExc_ValueError, "copies require USAGE_TRANSFER on both resources");
+    }
+
+    if (size == 0 && self->buffer && dst_resource->buffer)
+    {
+        size = self->size;
+    }
+
+    // bufferRowLength/bufferImageHeight are expressed in texels
+    vulkan_Resource *texture_resource = self->buffer ? dst_resource : self;
+    const uint32_t bytes_per_pixel = texture_resource->image ? (uint32_t)(texture_resource->row_pitch / texture_resource->image_extent.width) : 1;
+
+    if (!compushady_check_copy_to(self->buffer,
+                                  dst_resource->buffer, size, src_offset, dst_offset, self->size, dst_resource->size,
+                                  src_x, src_y, src_z, src_slice, self->slices, dst_slice, dst_resource->slices,
+                                  self->image_extent.width, self->image_extent.height, self->image_extent.depth,
+                                  dst_resource->image_extent.width, dst_resource->image_extent.height, dst_resource->image_extent.depth,
+                                  &dst_x, &dst_y, &dst_z, &width, &height, &depth,
+                                  bytes_per_pixel, bytes_per_pixel, &buffer_row_pitch, &buffer_slice_pitch))
+    {
+        return NULL;
+    }
+
+    // slice and z-range views address a sub-range of the owner image
+    src_slice += self->first_slice;
+    src_z += self->first_z;
+    dst_slice += dst_resource->first_slice;
+    dst_z += dst_resource->first_z;
+
+    vulkan_Device_begin(self->py_device);
+    if (self->buffer && dst_resource->buffer)
+    {
+        VkBufferCopy buffer_copy = {};
+        buffer_copy.srcOffset = self->buffer_offset + src_offset;
+        buffer_copy.dstOffset = dst_resource->buffer_offset + dst_offset;
+        buffer_copy.size = size;
+        vkCmdCopyBuffer(
+            self->py_device->command_buffer, self->buffer, dst_resource->buffer, 1, &buffer_copy);
+    }
+    else if (self->buffer) // buffer to image
+    {
+        VkImageMemoryBarrier image_memory_barrier = {};
+        image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_memory_barrier.image = dst_resource->image;
+        image_memory_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_memory_barrier.subresourceRange.baseMipLevel = dst_resource->mip;
+        image_memory_barrier.subresourceRange.levelCount = 1;
+        image_memory_barrier.subresourceRange.baseArrayLayer = dst_slice;
+        image_memory_barrier.subresourceRange.layerCount = 1;
+        image_memory_barrier.oldLayout = dst_resource->layout;
+        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
+        VkBufferImageCopy buffer_image_copy = {};
+        buffer_image_copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        buffer_image_copy.imageSubresource.mipLevel = dst_resource->mip;
+        buffer_image_copy.imageSubresource.baseArrayLayer = dst_slice;
+        buffer_image_copy.imageSubresource.layerCount = 1;
+        buffer_image_copy.imageOffset.x = dst_x;
+        buffer_image_copy.imageOffset.y = dst_y;
+        buffer_image_copy.imageOffset.z = dst_z;
+        buffer_image_copy.imageExtent.width = width;
+        buffer_image_copy.imageExtent.height = height;
+        buffer_image_copy.imageExtent.depth = depth;
+        buffer_image_copy.bufferOffset = self->buffer_offset + src_offset;
+        buffer_image_copy.bufferRowLength = (uint32_t)(buffer_row_pitch / bytes_per_pixel);
+        buffer_image_copy.bufferImageHeight = (uint32_t)(buffer_slice_pitch / buffer_row_pitch);
+        vkCmdCopyBufferToImage(self->py_device->command_buffer, self->buffer, dst_resource->image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &buffer_image_copy);
+        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        image_memory_barrier.newLayout = dst_resource->layout;
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
+    }
+    else if (dst_resource->buffer) // image to buffer
+    {
+        VkImageMemoryBarrier image_memory_barrier = {};
+        image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_memory_barrier.image = self->image;
+        image_memory_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_memory_barrier.subresourceRange.baseMipLevel = self->mip;
+        image_memory_barrier.subresourceRange.levelCount = 1;
+        image_memory_barrier.subresourceRange.baseArrayLayer = src_slice;
+        image_memory_barrier.subresourceRange.layerCount = 1;
+        image_memory_barrier.oldLayout = self->layout;
+        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
                              VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
         VkBufferImageCopy buffer_image_copy = {};
         buffer_image_copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        buffer_image_copy.imageSubresource.baseArrayLayer = dst_slice;
+        buffer_image_copy.imageSubresource.mipLevel = self->mip;
+        buffer_image_copy.imageSubresource.baseArrayLayer = src_slice;
         buffer_image_copy.imageSubresource.layerCount = 1;
-        buffer_image_copy.imageExtent = dst_resource->image_extent;
-        buffer_image_copy.bufferOffset = src_offset;
-        vkCmdCopyBufferToImage(self->py_device->command_buffer, self->buffer, dst_resource->image,
-                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &buffer_image_copy);
-        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        buffer_image_copy.imageOffset.x = src_x;
+        buffer_image_copy.imageOffset.y = src_y;
+        buffer_image_copy.imageOffset.z = src_z;
+        buffer_image_copy.imageExtent.width = width;
+        buffer_image_copy.imageExtent.height = height;
+        buffer_image_copy.imageExtent.depth = depth;
+        buffer_image_copy.bufferOffset = dst_resource->buffer_offset + dst_offset;
+        buffer_image_copy.bufferRowLength = (uint32_t)(buffer_row_pitch / bytes_per_pixel);
+        buffer_image_copy.bufferImageHeight = (uint32_t)(buffer_slice_pitch / buffer_row_pitch);
+        vkCmdCopyImageToBuffer(self->py_device->command_buffer, self->image,
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_resource->buffer, 1, &buffer_image_copy);
+        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_memory_barrier.newLayout = self->layout;
         vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
                              VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
     }
-    else if (dst_resource->buffer) // image to buffer
+    else // image to image
+    {
+        VkImageMemoryBarrier image_memory_barrier[2] = {};
+        image_memory_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_memory_barrier[0].image = self->image;
+        image_memory_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_memory_barrier[0].subresourceRange.baseMipLevel = self->mip;
+        image_memory_barrier[0].subresourceRange.levelCount = 1;
+        image_memory_barrier[0].subresourceRange.baseArrayLayer = src_slice;
+        image_memory_barrier[0].subresourceRange.layerCount = 1;
+        image_memory_barrier[0].oldLayout = self->layout;
+        image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_memory_barrier[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_memory_barrier[1].image = dst_resource->image;
+        image_memory_barrier[1].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_memory_barrier[1].subresourceRange.baseMipLevel = dst_resource->mip;
+        image_memory_barrier[1].subresourceRange.levelCount = 1;
+        image_memory_barrier[1].subresourceRange.baseArrayLayer = dst_slice;
+        image_memory_barrier[1].subresourceRange.layerCount = 1;
+        image_memory_barrier[1].oldLayout = dst_resource->layout;
+        image_memory_barrier[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
+        VkImageCopy image_copy = {};
+        image_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_copy.srcSubresource.mipLevel = self->mip;
+        image_copy.srcSubresource.baseArrayLayer = src_slice;
+        image_copy.srcSubresource.layerCount = 1;
+        image_copy.srcOffset.x = src_x;
+        image_copy.srcOffset.y = src_y;
+        image_copy.srcOffset.z = src_z;
+        image_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_copy.dstSubresource.mipLevel = dst_resource->mip;
+        image_copy.dstSubresource.baseArrayLayer = dst_slice;
+        image_copy.dstSubresource.layerCount = 1;
+        image_copy.dstOffset.x = dst_x;
+        image_copy.dstOffset.y = dst_y;
+        image_copy.dstOffset.z = dst_z;
+        image_copy.extent.width = width;
+        image_copy.extent.height = height;
+        image_copy.extent.depth = depth;
+        vkCmdCopyImage(self->py_device->command_buffer, self->image,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_resource->image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
+        image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_memory_barrier[0].newLayout = self->layout;
+        image_memory_barrier[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        image_memory_barrier[1].newLayout = dst_resource->layout;
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
+    }
+
+
+    if (vulkan_Device_submit_and_wait(self->py_device) == VK_SUCCESS)
+    {
+        Py_RETURN_NONE;
+    }
+
+    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+}
+
+static bool vulkan_Resource_prepare_tile(vulkan_Resource *self, const uint32_t x, const uint32_t y, const uint32_t z, PyObject *py_heap, const uint64_t heap_offset, const uint32_t slice,
+                                         VkSparseMemoryBind *sparse_memory_bind, VkSparseImageMemoryBind *sparse_image_memory_bind, vulkan_Heap **py_vulkan_heap)
+{
+    if (x >= self->tiles_x || y >= self->tiles_y || z >= self->tiles_z)
+    {
+        PyErr_Format(PyExc_ValueError,
+                     "Tile (%u, %u, %u) is out of bounds "
+                     "(tiles_x: %u, tiles_y: %u, tiles_z: %u)",
+                     x, y, z, self->tiles_x, self->tiles_y, self->tiles_z);
+        return false;
+    }
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    *py_vulkan_heap = NULL;
+    if (py_heap && py_heap != Py_None)
+    {
+        int ret = PyObject_IsInstance(py_heap, (PyObject *)&vulkan_Heap_Type);
+        if (ret < 0)
+        {
+            return false;
+        }
+        else if (ret == 0)
+        {
+            PyErr_Format(PyExc_ValueError, "Expected a Heap object");
+            return false;
+        }
+
+        *py_vulkan_heap = (vulkan_Heap *)py_heap;
+
+        if ((*py_vulkan_heap)->py_device != self->py_device)
+        {
+            PyErr_Format(PyExc_ValueError, "Cannot use heap from a different device");
+            return false;
+        }
+
+        if ((*py_vulkan_heap)->heap_type != self->heap_type)
+        {
+            PyErr_Format(Compushady_BufferError, "Unsupported heap type");
+            return false;
+        }
+
+        if (heap_offset >= (*py_vulkan_heap)->size)
+        {
+            PyErr_Format(Compushady_BufferError,
+                         "Invalid heap offset (%llu) "
+                         "(heap size %llu)",
+                         heap_offset, (*py_vulkan_heap)->size);
+            return false;
+        }
+
+        memory = (*py_vulkan_heap)->memory;
+    }
+
+    if (self->buffer)
+    {
+        *sparse_memory_bind = {};
+        sparse_memory_bind->memory = memory;
+        sparse_memory_bind->memoryOffset = heap_offset;
+        sparse_memory_bind->resourceOffset = x * self->tile_width;
+        sparse_memory_bind->size = self->tile_width;
+    }
+    else
+    {
+        *sparse_image_memory_bind = {};
+        sparse_image_memory_bind->subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        sparse_image_memory_bind->subresource.arrayLayer = slice;
+        sparse_image_memory_bind->offset.x = x * self->tile_width;
+        sparse_image_memory_bind->offset.y = y * self->tile_height;
+        sparse_image_memory_bind->offset.z = z * self->tile_depth;
+        sparse_image_memory_bind->extent.width = self->tile_width;
+        sparse_image_memory_bind->extent.height = self->tile_height;
+        sparse_image_memory_bind->extent.depth = self->tile_depth;
+        sparse_image_memory_bind->memory = memory;
+        sparse_image_memory_bind->memoryOffset = heap_offset;
+    }
+
+    return true;
+}
+
+/*
+ * Submits all of the binds with a single vkQueueBindSparse.
+ * Completion is signaled on a device semaphore that the next submission will wait for.
+ */
+static VkResult vulkan_Resource_bind_sparse(vulkan_Resource *self, std::vector<VkSparseMemoryBind> &sparse_memory_binds, std::vector<VkSparseImageMemoryBind> &sparse_image_memory_binds)
+{
+    vulkan_Device *py_device = self->py_device;
+
+    VkSemaphoreCreateInfo semaphore_create_info = {};
+    semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (!py_device->sparse_semaphores[i])
+        {
+            VkResult result = vkCreateSemaphore(py_device->device, &semaphore_create_info, NULL, &py_device->sparse_semaphores[i]);
+            if (result != VK_SUCCESS)
+            {
+                return result;
+            }
+        }
+    }
+
+    VkBindSparseInfo bind_sparse_info = {};
+    bind_sparse_info.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    VkSparseBufferMemoryBindInfo sparse_buffer_memory_bind_info = {};
+    VkSparseImageMemoryBindInfo sparse_image_memory_bind_info = {};
+
+    if (self->buffer)
+    {
+        sparse_buffer_memory_bind_info.buffer = self->buffer;
+        sparse_buffer_memory_bind_info.bindCount = (uint32_t)sparse_memory_binds.size();
+        sparse_buffer_memory_bind_info.pBinds = sparse_memory_binds.data();
+        bind_sparse_info.bufferBindCount = 1;
+        bind_sparse_info.pBufferBinds = &sparse_buffer_memory_bind_info;
+    }
+    else
+    {
+        sparse_image_memory_bind_info.image = self->image;
+        sparse_image_memory_bind_info.bindCount = (uint32_t)sparse_image_memory_binds.size();
+        sparse_image_memory_bind_info.pBinds = sparse_image_memory_binds.data();
+        bind_sparse_info.imageBindCount = 1;
+        bind_sparse_info.pImageBinds = &sparse_image_memory_bind_info;
+    }
+
+    // binary semaphores cannot be signaled twice, so chain the previous (still pending) binding
+    uint32_t signal_index = py_device->sparse_semaphore_index;
+    if (py_device->sparse_pending)
+    {
+        bind_sparse_info.waitSemaphoreCount = 1;
+        bind_sparse_info.pWaitSemaphores = &py_device->sparse_semaphores[py_device->sparse_semaphore_index];
+        signal_index = (signal_index + 1) % 2;
+    }
+    bind_sparse_info.signalSemaphoreCount = 1;
+    bind_sparse_info.pSignalSemaphores = &py_device->sparse_semaphores[signal_index];
+
+    // the binding is tracked by the fence of a submission like the command buffers
+    vulkan_Device_acquire_command_buffer(py_device);
+    vulkan_Submission *submission = vulkan_Device_get_submission(py_device);
+
+    VkResult result = vkQueueBindSparse(py_device->queue, 1, &bind_sparse_info, submission ? submission->fence : VK_NULL_HANDLE);
+    if (result == VK_SUCCESS)
+    {
+        py_device->sparse_semaphore_index = signal_index;
+        py_device->sparse_pending = true;
+        vulkan_Device_submitted(py_device, submission);
+    }
+    return result;
+}
+
+/*
+ * Keeps alive the Heaps referenced by the bound tiles (a Heap is held until the resource is destroyed).
+ */
+static void vulkan_Resource_keep_tile_heap(vulkan_Resource *self, vulkan_Heap *py_heap)
+{
+    if (!py_heap)
+    {
+        return;
+    }
+
+    if (!self->tile_heaps)
+    {
+        self->tile_heaps = new std::vector<vulkan_Heap *>();
+    }
+
+    for (vulkan_Heap *py_tile_heap : *self->tile_heaps)
+    {
+        if (py_tile_heap == py_heap)
+        {
+            return;
+        }
+    }
+
+    Py_INCREF(py_heap);
+    self->tile_heaps->push_back(py_heap);
+}
+
+static PyObject *vulkan_Resource_bind_tile(vulkan_Resource *self, PyObject *args)
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+    PyObject *py_heap;
+    uint64_t heap_offset;
+    uint32_t slice;
+    if (!PyArg_ParseTuple(args, "IIIOKI", &x, &y, &z, &py_heap, &heap_offset, &slice))
+        return NULL;
+
+    if (self->tiles_x == 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "Not a sparsed Resource");
+    }
+
+    std::vector<VkSparseMemoryBind> sparse_memory_binds(1);
+    std::vector<VkSparseImageMemoryBind> sparse_image_memory_binds(1);
+    vulkan_Heap *py_vulkan_heap = NULL;
+
+    if (!vulkan_Resource_prepare_tile(self, x, y, z, py_heap, heap_offset, slice, sparse_memory_binds.data(), sparse_image_memory_binds.data(), &py_vulkan_heap))
+    {
+        return NULL;
+    }
+
+    vulkan_Resource_keep_tile_heap(self, py_vulkan_heap);
+
+    VkResult result = vulkan_Resource_bind_sparse(self, sparse_memory_binds, sparse_image_memory_binds);
+
+    if (result == VK_SUCCESS)
+    {
+        vulkan_Device_wait(self->py_device);
+        Py_RETURN_NONE;
+    }
+
+    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+}
+
+static PyObject *vulkan_Resource_bind_tiles(vulkan_Resource *self, PyObject *args)
+{
+    PyObject *py_tiles;
+    if (!PyArg_ParseTuple(args, "O", &py_tiles))
+        return NULL;
+
+    if (self->tiles_x == 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "Not a sparsed Resource");
+    }
+
+    PyObject *py_iter = PyObject_GetIter(py_tiles);
+    if (!py_iter)
+    {
+        return NULL;
+    }
+
+    std::vector<VkSparseMemoryBind> sparse_memory_binds;
+    std::vector<VkSparseImageMemoryBind> sparse_image_memory_binds;
+
+    while (PyObject *py_item = PyIter_Next(py_iter))
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t z;
+        PyObject *py_heap;
+        uint64_t heap_offset = 0;
+        uint32_t slice = 0;
+        if (!PyTuple_Check(py_item) || !PyArg_ParseTuple(py_item, "IIIO|KI", &x, &y, &z, &py_heap, &heap_offset, &slice))
+        {
+            if (!PyErr_Occurred())
+            {
+                PyErr_Format(PyExc_ValueError, "Expected a tuple (x, y, z, heap, heap_offset, slice)");
+            }
+            Py_DECREF(py_item);
+            Py_DECREF(py_iter);
+            return NULL;
+        }
+
+        VkSparseMemoryBind sparse_memory_bind;
+        VkSparseImageMemoryBind sparse_image_memory_bind;
+        vulkan_Heap *py_vulkan_heap = NULL;
+        bool valid = vulkan_Resource_prepare_tile(self, x, y, z, py_heap, heap_offset, slice, &sparse_memory_bind, &sparse_image_memory_bind, &py_vulkan_heap);
+        Py_DECREF(py_item);
+        if (!valid)
+        {
+            Py_DECREF(py_iter);
+            return NULL;
+        }
+
+        if (self->buffer)
+        {
+            sparse_memory_binds.push_back(sparse_memory_bind);
+        }
+        else
+        {
+            sparse_image_memory_binds.push_back(sparse_image_memory_bind);
+        }
+
+        vulkan_Resource_keep_tile_heap(self, py_vulkan_heap);
+    }
+
+    Py_DECREF(py_iter);
+
+    if (PyErr_Occurred())
+    {
+        return NULL;
+    }
+
+    if (sparse_memory_binds.empty() && sparse_image_memory_binds.empty())
+    {
+        Py_RETURN_NONE;
+    }
+
+    if (vulkan_Resource_bind_sparse(self, sparse_memory_binds, sparse_image_memory_binds) == VK_SUCCESS)
+    {
+        Py_RETURN_NONE;
+    }
+
+    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+}
+
+static PyObject *vulkan_Resource_mip(vulkan_Resource *self, PyObject *args)
+{
+    uint32_t mip;
+    if (!PyArg_ParseTuple(args, "I", &mip))
+        return NULL;
+
+    if (!self->image || self->py_parent)
+    {
+        return PyErr_Format(PyExc_ValueError, "mip views can only be created from Textures");
+    }
+
+    if (mip >= self->mips)
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid mip: %u (number of mips: %u)", mip, self->mips);
+    }
+
+    vulkan_Resource *py_resource = (vulkan_Resource *)PyObject_New(vulkan_Resource, &vulkan_Resource_Type);
+    if (!py_resource)
+    {
+        return PyErr_Format(PyExc_MemoryError, "unable to allocate vulkan Texture mip");
+    }
+    COMPUSHADY_CLEAR(py_resource);
+    py_resource->py_device = self->py_device;
+    Py_INCREF(py_resource->py_device);
+    py_resource->py_parent = self;
+    Py_INCREF(py_resource->py_parent);
+
+    py_resource->image = self->image;
+    py_resource->memory = self->memory;
+    py_resource->usage = self->usage;
+    py_resource->layout = self->layout;
+
+    VkResult result = vulkan_texture_create_view(self->py_device->device, self->image, self->image_view_type, self->format, mip, 1, 0, self->slices, &py_resource->image_view);
+    if (result != VK_SUCCESS)
     {
-        VkImageMemoryBarrier image_memory_barrier = {};
-        image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        image_memory_barrier.image = self->image;
-        image_memory_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        image_memory_barrier.subresourceRange.levelCount = 1;
-        image_memory_barrier.subresourceRange.baseArrayLayer = src_slice;
-        image_memory_barrier.subresourceRange.layerCount = 1;
-        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        Py_DECREF(py_resource);
+        return PyErr_Format(PyExc_MemoryError, "unable to create vulkan Image View");
+    }
 
-        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
-        VkBufferImageCopy buffer_image_copy = {};
-        buffer_image_copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        buffer_image_copy.imageSubresource.baseArrayLayer = src_slice;
-        buffer_image_copy.imageSubresource.layerCount = 1;
-        buffer_image_copy.imageExtent = self->image_extent;
-        buffer_image_copy.bufferOffset = dst_offset;
-        vkCmdCopyImageToBuffer(self->py_device->command_buffer, self->image,
-                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_resource->buffer, 1, &buffer_image_copy);
-        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, 0, 0, 0, 1, &image_memory_barrier);
+    const uint64_t bytes_per_pixel = self->row_pitch / self->image_extent.width;
+
+    py_resource->image_extent.width = (self->image_extent.width >> mip) > 0 ? (self->image_extent.width >> mip) : 1;
+    py_resource->image_extent.height = (self->image_extent.height >> mip) > 0 ? (self->image_extent.height >> mip) : 1;
+    py_resource->image_extent.depth = (self->image_extent.depth >> mip) > 0 ? (self->image_extent.depth >> mip) : 1;
+    py_resource->descriptor_image_info.imageView = py_resource->image_view;
+    py_resource->descriptor_image_info.imageLayout = py_resource->layout;
+    py_resource->descriptor_storage_image_info = py_resource->descriptor_image_info;
+    py_resource->image_view_type = self->image_view_type;
+    py_resource->row_pitch = py_resource->image_extent.width * bytes_per_pixel;
+    py_resource->size = py_resource->row_pitch * py_resource->image_extent.height * py_resource->image_extent.depth; // always assume a packed configuration
+    py_resource->heap_offset = self->heap_offset;
+    py_resource->format = self->format;
+    py_resource->slices = self->slices;
+    py_resource->heap_type = self->heap_type;
+    py_resource->mips = 1;
+    py_resource->mip = mip;
+
+    return (PyObject *)py_resource;
+}
+
+/*
+ * Texture views select a range of array slices (or a range of depth slices for Texture3D) of the parent VkImage.
+ * A 3D image view cannot address a depth range for sampling, so Texture3D views (VK_EXT_image_sliced_view_of_3d)
+ * can only be bound as UAVs.
+ */
+static PyObject *vulkan_Resource_texture_view(vulkan_Resource *self, PyObject *args)
+{
+    uint32_t first_slice;
+    uint32_t num_slices = 0;
+    if (!PyArg_ParseTuple(args, "I|I", &first_slice, &num_slices))
+        return NULL;
+
+    if (self->py_parent)
+    {
+        return PyErr_Format(PyExc_ValueError, "views can only be created from Textures");
     }
-    else // image to image
+
+    vulkan_Device *py_device = self->py_device;
+    const bool is_3d = self->image_view_type == VK_IMAGE_VIEW_TYPE_3D;
+    const uint32_t max_slices = is_3d ? self->image_extent.depth : self->slices;
+
+    if (num_slices == 0 && first_slice < max_slices)
     {
-        VkImageMemoryBarrier image_memory_barrier[2] = {};
-        image_memory_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        image_memory_barrier[0].image = self->image;
-        image_memory_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        image_memory_barrier[0].subresourceRange.levelCount = 1;
-        image_memory_barrier[0].subresourceRange.baseArrayLayer = src_slice;
-        image_memory_barrier[0].subresourceRange.layerCount = 1;
-        image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        image_memory_barrier[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        image_memory_barrier[1].image = dst_resource->image;
-        image_memory_barrier[1].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        image_memory_barrier[1].subresourceRange.levelCount = 1;
-        image_memory_barrier[1].subresourceRange.baseArrayLayer = dst_slice;
-        image_memory_barrier[1].subresourceRange.layerCount = 1;
-        image_memory_barrier[1].oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        image_memory_barrier[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
-        VkImageCopy image_copy = {};
-        image_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        image_copy.srcSubresource.baseArrayLayer = src_slice;
-        image_copy.srcSubresource.layerCount = 1;
-        image_copy.srcOffset.x = src_x;
-        image_copy.srcOffset.y = src_y;
-        image_copy.srcOffset.z = src_z;
-        image_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        image_copy.dstSubresource.baseArrayLayer = dst_slice;
-        image_copy.dstSubresource.layerCount = 1;
-        image_copy.dstOffset.x = dst_x;
-        image_copy.dstOffset.y = dst_y;
-        image_copy.dstOffset.z = dst_z;
-        image_copy.extent.width = width;
-        image_copy.extent.height = height;
-        image_copy.extent.depth = depth;
-        vkCmdCopyImage(self->py_device->command_buffer, self->image,
-                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_resource->image,
-                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
-        image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_GENERAL;
-        image_memory_barrier[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        image_memory_barrier[1].newLayout = VK_IMAGE_LAYOUT_GENERAL;
-        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
+        num_slices = max_slices - first_slice;
+    }
+
+    if (num_slices == 0 || first_slice + num_slices > max_slices)
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid view range: (first slice %u) %u (number of slices %u)", first_slice, num_slices, max_slices);
+    }
+
+    if (is_3d)
+    {
+#ifdef VK_EXT_image_sliced_view_of_3d
+        if (!py_device->supports_sliced_view_of_3d)
+        {
+            return PyErr_Format(PyExc_ValueError, "Texture3D views are not supported by this device (VK_EXT_image_sliced_view_of_3d)");
+        }
+#else
+        return PyErr_Format(PyExc_ValueError, "Texture3D views are not supported by this build (VK_EXT_image_sliced_view_of_3d)");
+#endif
+        if (!(self->usage & COMPUSHADY_USAGE_STORAGE))
+        {
+            return PyErr_Format(PyExc_ValueError, "Texture3D views require a Texture3D with storage usage");
+        }
+    }
+
+    vulkan_Resource *py_resource = (vulkan_Resource *)PyObject_New(vulkan_Resource, &vulkan_Resource_Type);
+    if (!py_resource)
+    {
+        return PyErr_Format(PyExc_MemoryError, "unable to allocate vulkan Texture view");
+    }
+    COMPUSHADY_CLEAR(py_resource);
+    py_resource->py_device = py_device;
+    Py_INCREF(py_resource->py_device);
+    py_resource->py_parent = self;
+    Py_INCREF(py_resource->py_parent);
+
+    py_resource->image = self->image;
+    py_resource->memory = self->memory;
+    py_resource->image_extent = self->image_extent;
+    py_resource->row_pitch = self->row_pitch;
+    py_resource->usage = self->usage;
+    py_resource->layout = self->layout;
+
+    VkResult result = VK_SUCCESS;
+    if (is_3d)
+    {
+#ifdef VK_EXT_image_sliced_view_of_3d
+        VkImageViewSlicedCreateInfoEXT sliced_create_info = {};
+        sliced_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_SLICED_CREATE_INFO_EXT;
+        sliced_create_info.sliceOffset = first_slice;
+        sliced_create_info.sliceCount = num_slices;
+
+        VkImageViewCreateInfo image_view_create_info = {};
+        image_view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        image_view_create_info.pNext = &sliced_create_info;
+        image_view_create_info.image = self->image;
+        image_view_create_info.viewType = VK_IMAGE_VIEW_TYPE_3D;
+        image_view_create_info.format = self->format;
+        image_view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_view_create_info.subresourceRange.levelCount = 1;
+        image_view_create_info.subresourceRange.layerCount = 1;
+
+        result = vkCreateImageView(py_device->device, &image_view_create_info, NULL, &py_resource->storage_image_view);
+#endif
+        // no sampled image view: the depth range is visible only to storage image descriptors
+        py_resource->usage &= ~COMPUSHADY_USAGE_READ_ONLY;
+        py_resource->image_view_type = VK_IMAGE_VIEW_TYPE_3D;
+        py_resource->image_extent.depth = num_slices;
+        py_resource->first_z = first_slice;
+        py_resource->slices = 1;
+    }
+    else
+    {
+        VkImageViewType view_type = self->image_view_type;
+        if (num_slices == 1)
+        {
+            view_type = view_type == VK_IMAGE_VIEW_TYPE_1D_ARRAY ? VK_IMAGE_VIEW_TYPE_1D : (view_type == VK_IMAGE_VIEW_TYPE_2D_ARRAY ? VK_IMAGE_VIEW_TYPE_2D : view_type);
+        }
+        else
+        {
+            view_type = view_type == VK_IMAGE_VIEW_TYPE_1D ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : (view_type == VK_IMAGE_VIEW_TYPE_2D ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : view_type);
+        }
+
+        result = vulkan_texture_create_view(py_device->device, self->image, view_type, self->format, 0, self->mips, first_slice, num_slices, &py_resource->image_view);
+        if (result == VK_SUCCESS && self->mips > 1)
+        {
+            result = vulkan_texture_create_view(py_device->device, self->image, view_type, self->format, 0, 1, first_slice, num_slices, &py_resource->storage_image_view);
+        }
+        py_resource->image_view_type = view_type;
+        py_resource->first_slice = first_slice;
+        py_resource->slices = num_slices;
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        Py_DECREF(py_resource);
+        return PyErr_Format(PyExc_MemoryError, "unable to create vulkan Image View");
+    }
+
+    py_resource->descriptor_image_info.imageView = py_resource->image_view;
+    py_resource->descriptor_image_info.imageLayout = py_resource->layout;
+    py_resource->descriptor_storage_image_info = py_resource->descriptor_image_info;
+    if (py_resource->storage_image_view)
+    {
+        py_resource->descriptor_storage_image_info.imageView = py_resource->storage_image_view;
+    }
+
+    py_resource->size = py_resource->row_pitch * py_resource->image_extent.height * py_resource->image_extent.depth; // always assume a packed configuration
+    py_resource->heap_offset = self->heap_offset;
+    py_resource->format = self->format;
+    py_resource->heap_type = self->heap_type;
+    py_resource->mips = self->mips;
+
+    return (PyObject *)py_resource;
+}
+
+/*
+ * Buffer views alias a range of the parent VkBuffer (and its memory), so no new buffer or allocation is required.
+ */
+static PyObject *vulkan_Resource_view(vulkan_Resource *self, PyObject *args)
+{
+    if (self->image)
+    {
+        return vulkan_Resource_texture_view(self, args);
+    }
+
+    uint64_t offset;
+    uint64_t size = 0;
+    uint32_t stride = 0;
+    int format = 0;
+    if (!PyArg_ParseTuple(args, "K|KIi", &offset, &size, &stride, &format))
+        return NULL;
+
+    if (!self->buffer)
+    {
+        return PyErr_Format(PyExc_ValueError, "views can only be created from Buffers or Textures");
+    }
+
+    if (size == 0 && offset < self->size)
+    {
+        size = self->size - offset;
+    }
+
+    if (size == 0 || offset + size > self->size)
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid view range: (offset %llu) %llu (buffer size %llu)", offset, size, self->size);
+    }
+
+    if (format > 0 && vulkan_formats.find(format) == vulkan_formats.end())
+    {
+        return PyErr_Format(PyExc_ValueError, "invalid pixel format");
+    }
+
+    // views of views always reference the Buffer owning the VkBuffer
+    vulkan_Resource *py_owner = self->py_parent ? self->py_parent : self;
+
+    if (format > 0 && !(py_owner->usage & (COMPUSHADY_USAGE_READ_ONLY | COMPUSHADY_USAGE_STORAGE)))
+    {
+        return PyErr_Format(PyExc_ValueError, "formatted views require USAGE_READ_ONLY or USAGE_STORAGE");
+    }
+    vulkan_Device *py_device = self->py_device;
+    const uint64_t buffer_offset = self->buffer_offset + offset;
+
+    uint64_t alignment = py_device->min_storage_buffer_offset_alignment > py_device->min_uniform_buffer_offset_alignment ? py_device->min_storage_buffer_offset_alignment : py_device->min_uniform_buffer_offset_alignment;
+    if (format > 0 && py_device->min_texel_buffer_offset_alignment > alignment)
+    {
+        alignment = py_device->min_texel_buffer_offset_alignment;
+    }
+
+    if (alignment > 0 && (buffer_offset % alignment) != 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "view offset %llu is not aligned to %llu bytes", buffer_offset, alignment);
+    }
+
+    vulkan_Resource *py_resource = (vulkan_Resource *)PyObject_New(vulkan_Resource, &vulkan_Resource_Type);
+    if (!py_resource)
+    {
+        return PyErr_Format(PyExc_MemoryError, "unable to allocate vulkan Buffer view");
+    }
+    COMPUSHADY_CLEAR(py_resource);
+    py_resource->py_device = py_device;
+    Py_INCREF(py_resource->py_device);
+    py_resource->py_parent = py_owner;
+    Py_INCREF(py_resource->py_parent);
+
+    py_resource->buffer = py_owner->buffer;
+    py_resource->memory = py_owner->memory;
+    py_resource->usage = py_owner->usage;
+
+    if (format > 0)
+    {
+        py_resource->format = vulkan_formats[format].first;
+        VkBufferViewCreateInfo buffer_view_create_info = {};
+        buffer_view_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO;
+        buffer_view_create_info.buffer = py_resource->buffer;
+        buffer_view_create_info.format = py_resource->format;
+        buffer_view_create_info.offset = buffer_offset;
+        buffer_view_create_info.range = size;
+
+        VkResult result = vkCreateBufferView(py_device->device, &buffer_view_create_info, NULL, &py_resource->buffer_view);
+        if (result != VK_SUCCESS)
+        {
+            Py_DECREF(py_resource);
+            return PyErr_Format(Compushady_BufferError, "unable to create vulkan Buffer View");
+        }
+    }
+
+    if (py_owner->device_address)
+    {
+        py_resource->device_address = py_owner->device_address + buffer_offset;
+    }
+
+    py_resource->size = size;
+    // mapping (upload/readback) uses the memory offset
+    py_resource->heap_offset = py_owner->heap_offset + buffer_offset;
+    py_resource->buffer_offset = buffer_offset;
+    py_resource->stride = stride;
+    py_resource->descriptor_buffer_info.buffer = py_resource->buffer;
+    py_resource->descriptor_buffer_info.offset = buffer_offset;
+    py_resource->descriptor_buffer_info.range = size;
+    py_resource->heap_size = size;
+    py_resource->slices = 1;
+    py_resource->heap_type = self->heap_type;
+
+    return (PyObject *)py_resource;
+}
+
+static PyObject *vulkan_Resource_generate_mips(vulkan_Resource *self, PyObject *args)
+{
+    if (!self->image || self->py_parent)
+    {
+        return PyErr_Format(PyExc_ValueError, "mips can only be generated for Textures");
+    }
+
+    if (self->mips < 2)
+    {
+        Py_RETURN_NONE;
+    }
+
+    if (!(self->usage & COMPUSHADY_USAGE_TRANSFER))
+    {
+        return PyErr_Format(PyExc_ValueError, "mips generation requires USAGE_TRANSFER");
+    }
+
+    VkFormatProperties format_properties;
+    vkGetPhysicalDeviceFormatProperties(self->py_device->physical_device, self->format, &format_properties);
+
+    if (!(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT) || !(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT))
+    {
+        return PyErr_Format(PyExc_ValueError, "the Texture format does not support mips generation");
+    }
+
+    // integer formats do not support linear filtering
+    const VkFilter filter = (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+
+
+    vulkan_Device_begin(self->py_device);
+
+    // the whole chain stays in GENERAL layout, each level only needs to wait for the previous blit
+    VkImageMemoryBarrier image_memory_barrier = {};
+    image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_memory_barrier.image = self->image;
+    image_memory_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_memory_barrier.subresourceRange.levelCount = self->mips;
+    image_memory_barrier.subresourceRange.layerCount = self->slices;
+    image_memory_barrier.oldLayout = self->layout;
+    image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    if (self->layout != VK_IMAGE_LAYOUT_GENERAL)
+    {
+        image_memory_barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
+    }
+
+    image_memory_barrier.subresourceRange.levelCount = 1;
+    image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    int32_t width = self->image_extent.width;
+    int32_t height = self->image_extent.height;
+    int32_t depth = self->image_extent.depth;
+
+    for (uint32_t mip = 1; mip < self->mips; mip++)
+    {
+        image_memory_barrier.subresourceRange.baseMipLevel = mip - 1;
+        image_memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
+
+        VkImageBlit image_blit = {};
+        image_blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_blit.srcSubresource.mipLevel = mip - 1;
+        image_blit.srcSubresource.layerCount = self->slices;
+        image_blit.srcOffsets[1].x = width;
+        image_blit.srcOffsets[1].y = height;
+        image_blit.srcOffsets[1].z = depth;
+        width = width > 1 ? width >> 1 : 1;
+        height = height > 1 ? height >> 1 : 1;
+        depth = depth > 1 ? depth >> 1 : 1;
+        image_blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_blit.dstSubresource.mipLevel = mip;
+        image_blit.dstSubresource.layerCount = self->slices;
+        image_blit.dstOffsets[1].x = width;
+        image_blit.dstOffsets[1].y = height;
+        image_blit.dstOffsets[1].z = depth;
+
+        vkCmdBlitImage(self->py_device->command_buffer, self->image, VK_IMAGE_LAYOUT_GENERAL, self->image, VK_IMAGE_LAYOUT_GENERAL, 1, &image_blit, filter);
+    }
+
+    // move the chain back to the resource layout: the source levels have been read by the blits,
+    // while the last level has only been written (and never got a barrier in the loop)
+    VkImageMemoryBarrier final_barriers[2] = {image_memory_barrier, image_memory_barrier};
+    final_barriers[0].subresourceRange.baseMipLevel = 0;
+    final_barriers[0].subresourceRange.levelCount = self->mips - 1;
+    final_barriers[0].newLayout = self->layout;
+    final_barriers[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    final_barriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    final_barriers[1].subresourceRange.baseMipLevel = self->mips - 1;
+    final_barriers[1].subresourceRange.levelCount = 1;
+    final_barriers[1].newLayout = self->layout;
+    final_barriers[1].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    final_barriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 2, final_barriers);
+
+
+    if (vulkan_Device_submit_and_wait(self->py_device) == VK_SUCCESS)
+    {
+        Py_RETURN_NONE;
+    }
+
+    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+}
+
+static PyMethodDef vulkan_Resource_methods[] = {
+    {"get_bindless_index", (PyCFunction)vulkan_Resource_get_bindless_index, METH_NOARGS,
+     "Registers the resource in the device bindless heap (if required) and returns its index"},
+    {"upload", (PyCFunction)(void (*)(void))vulkan_Resource_upload, COMPUSHADY_METH_FASTCALL,
+     "Upload bytes to a GPU Resource"},
+    {"upload2d", (PyCFunction)vulkan_Resource_upload2d, METH_VARARGS,
+     "Upload bytes to a GPU Resource given pitch, width, height and pixel "
+     "size"},
+    {"upload_chunked", (PyCFunction)vulkan_Resource_upload_chunked, METH_VARARGS,
+     "Upload bytes to a GPU Resource with the given stride and a filler"},
+    {"readback", (PyCFunction)(void (*)(void))vulkan_Resource_readback, COMPUSHADY_METH_FASTCALL,
+     "Readback bytes from a GPU Resource"},
+    {"readback2d", (PyCFunction)vulkan_Resource_readback2d, METH_VARARGS,
+     "Readback bytes from a GPU Resource given pitch, width, height and "
+     "pixel "
+     "size"},
+    {"readback_to_buffer", (PyCFunction)vulkan_Resource_readback_to_buffer, METH_VARARGS,
+     "Readback into a buffer from a GPU Resource"},
+    {"upload_file", (PyCFunction)vulkan_Resource_upload_file, METH_VARARGS,
+     "Upload a range of a file to a GPU Resource"},
+    {"readback_to_file", (PyCFunction)vulkan_Resource_readback_to_file, METH_VARARGS,
+     "Readback a range of a GPU Resource to a file"},
+    {"copy_to", (PyCFunction)(void (*)(void))vulkan_Resource_copy_to, COMPUSHADY_METH_FASTCALL,
+     "Copy resource content to another resource"},
+    {"bind_tile", (PyCFunction)vulkan_Resource_bind_tile, METH_VARARGS, "Bind a sparse resource tile to a heap"},
+    {"bind_tiles", (PyCFunction)vulkan_Resource_bind_tiles, METH_VARARGS, "Bind a list of sparse resource tiles with a single submission"},
+    {"mip", (PyCFunction)vulkan_Resource_mip, METH_VARARGS, "Create a view of a single Texture mip"},
+    {"view", (PyCFunction)vulkan_Resource_view, METH_VARARGS, "Create a view of a range of a Buffer or of the slices of a Texture"},
+    {"generate_mips", (PyCFunction)vulkan_Resource_generate_mips, METH_NOARGS, "Generate the Texture mip chain from the first mip"},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+static PyObject *vulkan_Swapchain_present(vulkan_Swapchain *self, PyObject *args)
+{
+    PyObject *py_resource;
+    uint32_t x;
+    uint32_t y;
+    if (!PyArg_ParseTuple(args, "OII", &py_resource, &x, &y))
+        return NULL;
+
+    int ret = PyObject_IsInstance(py_resource, (PyObject *)&vulkan_Resource_Type);
+    if (ret < 0)
+    {
+        return NULL;
+    }
+    else if (ret == 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
+    }
+    vulkan_Resource *src_resource = (vulkan_Resource *)py_resource;
+    if (!src_resource->image)
+    {
+        return PyErr_Format(PyExc_ValueError, "Expected a Texture object");
     }
 
-    vkEndCommandBuffer(self->py_device->command_buffer);
+    if (!(src_resource->usage & COMPUSHADY_USAGE_TRANSFER))
+    {
+        return PyErr_Format(PyExc_ValueError, "presenting a Texture requires USAGE_TRANSFER");
+    }
 
-    VkSubmitInfo submit_info = {};
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.pCommandBuffers = &self->py_device->command_buffer;
-    submit_info.commandBufferCount = 1;
+    uint32_t index = 0;
+    VkResult result = vkAcquireNextImageKHR(self->py_device->device, self->swapchain, UINT64_MAX,
+                                            self->copy_semaphore, VK_NULL_HANDLE, &index);
+    if (result != VK_SUCCESS)
+    {
+        return PyErr_Format(PyExc_Exception, "unable to acquire next image from Swapchain");
+    }
+
+    x = Py_MIN(x, self->image_extent.width - 1);
+    y = Py_MIN(y, self->image_extent.height - 1);
+
+
+    VkImageMemoryBarrier image_memory_barrier[2] = {};
+    image_memory_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_memory_barrier[0].image = self->images[index];
+    image_memory_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_memory_barrier[0].subresourceRange.levelCount = 1;
+    image_memory_barrier[0].subresourceRange.layerCount = 1;
+    image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    image_memory_barrier[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_memory_barrier[1].image = src_resource->image;
+    image_memory_barrier[1].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_memory_barrier[1].subresourceRange.levelCount = 1;
+    image_memory_barrier[1].subresourceRange.layerCount = 1;
+    image_memory_barrier[1].oldLayout = src_resource->layout;
+    image_memory_barrier[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkImageCopy image_copy = {};
+    image_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_copy.srcSubresource.layerCount = 1;
+    image_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    image_copy.dstSubresource.layerCount = 1;
+    image_copy.extent.width = Py_MIN(src_resource->image_extent.width, self->image_extent.width - x);
+    image_copy.extent.height = Py_MIN(src_resource->image_extent.height, self->image_extent.height - y);
+    image_copy.extent.depth = 1;
+    image_copy.dstOffset.x = x;
+    image_copy.dstOffset.y = y;
 
-    VkResult result = vkQueueSubmit(self->py_device->queue, 1, &submit_info, VK_NULL_HANDLE);
+    vulkan_Device_begin(self->py_device);
+    vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
+    vkCmdCopyImage(self->py_device->command_buffer, src_resource->image,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, self->images[index],
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
+    image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    image_memory_barrier[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_memory_barrier[1].newLayout = src_resource->layout;
+    vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
+
+    result = vulkan_Device_submit(self->py_device, self->copy_semaphore, VK_PIPELINE_STAGE_TRANSFER_BIT, self->present_semaphore);
+
+    if (result != VK_SUCCESS)
+    {
+        return PyErr_Format(PyExc_Exception, "unable to copy image to Swapchain: %d", result);
+    }
+
+    VkPresentInfoKHR present_info = {};
+    present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    present_info.pSwapchains = &(self->swapchain);
+    present_info.swapchainCount = 1;
+    present_info.pImageIndices = &index;
+    present_info.waitSemaphoreCount = 1;
+    present_info.pWaitSemaphores = &(self->present_semaphore);
+    result = vkQueuePresentKHR(self->py_device->queue, &present_info);
 
     if (result == VK_SUCCESS)
     {
-        Py_BEGIN_ALLOW_THREADS;
-        vkQueueWaitIdle(self->py_device->queue);
-        Py_END_ALLOW_THREADS;
+        vulkan_Device_wait(self->py_device);
         Py_RETURN_NONE;
     }
 
-    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+    return PyErr_Format(PyExc_Exception, "unable to present Swapchain: %d", result);
 }
 
-static PyObject *vulkan_Resource_bind_tile(vulkan_Resource *self, PyObject *args)
+static PyMethodDef vulkan_Swapchain_methods[] = {
+    {"present", (PyCFunction)vulkan_Swapchain_present, METH_VARARGS,
+     "Blit a texture resource to the Swapchain and present it"},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+static bool vulkan_Compute_fill_push_writes(vulkan_Compute *self, PyObject **py_sequences, std::vector<VkWriteDescriptorSet> &writes)
 {
-    uint32_t x;
-    uint32_t y;
-    uint32_t z;
-    PyObject *py_heap;
-    uint64_t heap_offset;
-    uint32_t slice;
-    if (!PyArg_ParseTuple(args, "IIIOKI", &x, &y, &z, &py_heap, &heap_offset, &slice))
-        return NULL;
+    PyObject *py_lists[4] = {self->py_cbv_list, self->py_srv_list, self->py_uav_list, self->py_samplers_list};
 
-    if (self->tiles_x == 0)
+    for (VkWriteDescriptorSet &write_descriptor_set : writes)
     {
-        return PyErr_Format(PyExc_ValueError, "Not a sparsed Resource");
-    }
+        const uint32_t kind = write_descriptor_set.dstBinding / 1024;
+        const uint32_t index = write_descriptor_set.dstBinding % 1024;
 
-    if (x >= self->tiles_x || y >= self->tiles_y || z >= self->tiles_z)
-    {
-        return PyErr_Format(PyExc_ValueError,
-                            "Tile (%u, %u, %u) is out of bounds "
-                            "(tiles_x: %u, tiles_y: %u, tiles_z: %u)",
-                            x, y, z, self->tiles_x, self->tiles_y, self->tiles_z);
-    }
+        if (kind == 3)
+        {
+            vulkan_Sampler *py_sampler = (vulkan_Sampler *)PyList_GetItem(py_lists[kind], index);
+            write_descriptor_set.pImageInfo = &py_sampler->descriptor_image_info;
+            continue;
+        }
 
-    VkDeviceMemory memory = VK_NULL_HANDLE;
-    if (py_heap && py_heap != Py_None)
-    {
-        int ret = PyObject_IsInstance(py_heap, (PyObject *)&vulkan_Heap_Type);
+        PyObject *py_item = PyList_GetItem(py_lists[kind], index);
+        PyObject *py_sequence = py_sequences[kind];
+        if (py_sequence && (Py_ssize_t)index < PySequence_Fast_GET_SIZE(py_sequence) && PySequence_Fast_GET_ITEM(py_sequence, index) != Py_None)
+        {
+            py_item = PySequence_Fast_GET_ITEM(py_sequence, index);
+        }
+
+        const int ret = PyObject_IsInstance(py_item, (PyObject *)&vulkan_Resource_Type);
         if (ret < 0)
         {
-            return NULL;
+            return false;
         }
         else if (ret == 0)
         {
-            return PyErr_Format(PyExc_ValueError, "Expected a Heap object");
+            PyErr_Format(PyExc_ValueError, "Expected a Resource object");
+            return false;
         }
 
-        vulkan_Heap *py_vulkan_heap = (vulkan_Heap *)py_heap;
-
-        if (py_vulkan_heap->py_device != self->py_device)
+        vulkan_Resource *py_resource = (vulkan_Resource *)py_item;
+        if (py_resource->py_device != self->py_device)
         {
-            return PyErr_Format(PyExc_ValueError, "Cannot use heap from a different device");
+            PyErr_Format(PyExc_ValueError, "Cannot use resources from a different device");
+            return false;
         }
 
-        if (py_vulkan_heap->heap_type != self->heap_type)
+        if (!vulkan_Resource_check_usage(py_resource, kind))
         {
-            return PyErr_Format(Compushady_BufferError, "Unsupported heap type");
+            return false;
         }
 
-        if (heap_offset >= py_vulkan_heap->size)
+        switch (write_descriptor_set.descriptorType)
         {
-            return PyErr_Format(Compushady_BufferError,
-                                "Invalid heap offset (%llu) "
-                                "(heap size %llu)",
-                                heap_offset, py_vulkan_heap->size);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            if (!py_resource->buffer || (kind > 0 && py_resource->buffer_view))
+            {
+                PyErr_Format(PyExc_ValueError, "Expected a non formatted Buffer for binding %u", write_descriptor_set.dstBinding);
+                return false;
+            }
+            write_descriptor_set.pBufferInfo = &py_resource->descriptor_buffer_info;
+            break;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            if (!py_resource->buffer_view)
+            {
+                PyErr_Format(PyExc_ValueError, "Expected a formatted Buffer for binding %u", write_descriptor_set.dstBinding);
+                return false;
+            }
+            write_descriptor_set.pTexelBufferView = &py_resource->buffer_view;
+            break;
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            if (!py_resource->image)
+            {
+                PyErr_Format(PyExc_ValueError, "Expected a Texture for binding %u", write_descriptor_set.dstBinding);
+                return false;
+            }
+            write_descriptor_set.pImageInfo = write_descriptor_set.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ? &py_resource->descriptor_image_info : &py_resource->descriptor_storage_image_info;
+            break;
+        default:
+            break;
         }
-
-        memory = py_vulkan_heap->memory;
     }
 
-    Py_XDECREF(self->py_heap);
-    self->py_heap = memory ? (vulkan_Heap *)py_heap : NULL;
-    Py_XINCREF(self->py_heap);
+    return true;
+}
 
-    VkBindSparseInfo bind_sparse_info = {};
-    bind_sparse_info.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
-    VkSparseBufferMemoryBindInfo sparse_buffer_memory_bind_info = {};
-    VkSparseImageMemoryBindInfo sparse_image_memory_bind_info = {};
-    VkSparseMemoryBind sparse_memory_bind = {};
-    VkSparseImageMemoryBind sparse_image_memory_bind = {};
+/*
+ * Builds the push descriptors writes of a Compute pipeline, optionally replacing
+ * the resources passed at creation time (None items keep the original resource).
+ */
+static bool vulkan_Compute_get_push_writes(vulkan_Compute *self, PyObject *py_cbv, PyObject *py_srv, PyObject *py_uav, std::vector<VkWriteDescriptorSet> &writes)
+{
+    PyObject *py_overrides[3] = {py_cbv, py_srv, py_uav};
 
-    if (self->buffer)
+    if (!self->push_descriptors)
     {
-        sparse_memory_bind.memory = memory;
-        sparse_memory_bind.memoryOffset = heap_offset;
-        sparse_memory_bind.resourceOffset = x * self->tile_width;
-        sparse_memory_bind.size = self->tile_width;
-        sparse_buffer_memory_bind_info.buffer = self->buffer;
-        sparse_buffer_memory_bind_info.bindCount = 1;
-        sparse_buffer_memory_bind_info.pBinds = &sparse_memory_bind;
-        bind_sparse_info.bufferBindCount = 1;
-        bind_sparse_info.pBufferBinds = &sparse_buffer_memory_bind_info;
+        for (PyObject *py_override : py_overrides)
+        {
+            if (py_override && py_override != Py_None)
+            {
+                PyErr_Format(PyExc_ValueError, "Compute pipeline has not been created with push descriptors");
+                return false;
+            }
+        }
+        return true;
     }
-    else
+
+    // convert each override only once, the writes reference its items by index
+    PyObject *py_sequences[3] = {NULL, NULL, NULL};
+    bool success = true;
+    for (size_t i = 0; i < 3; i++)
     {
-        sparse_image_memory_bind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        sparse_image_memory_bind.subresource.arrayLayer = slice;
-        sparse_image_memory_bind.offset.x = x * self->tile_width;
-        sparse_image_memory_bind.offset.y = y * self->tile_height;
-        sparse_image_memory_bind.offset.z = z * self->tile_depth;
-        sparse_image_memory_bind.extent.width = self->tile_width;
-        sparse_image_memory_bind.extent.height = self->tile_height;
-        sparse_image_memory_bind.extent.depth = self->tile_depth;
-        sparse_image_memory_bind.memory = memory;
-        sparse_image_memory_bind.memoryOffset = heap_offset;
-        sparse_image_memory_bind_info.image = self->image;
-        sparse_image_memory_bind_info.bindCount = 1;
-        sparse_image_memory_bind_info.pBinds = &sparse_image_memory_bind;
-        bind_sparse_info.imageBindCount = 1;
-        bind_sparse_info.pImageBinds = &sparse_image_memory_bind_info;
+        if (py_overrides[i] && py_overrides[i] != Py_None)
+        {
+            py_sequences[i] = PySequence_Fast(py_overrides[i], "Expected a sequence of Resource objects");
+            if (!py_sequences[i])
+            {
+                success = false;
+                break;
+            }
+        }
     }
 
-    VkResult result = vkQueueBindSparse(self->py_device->queue, 1, &bind_sparse_info, VK_NULL_HANDLE);
-
-    if (result == VK_SUCCESS)
+    if (success)
     {
-        Py_BEGIN_ALLOW_THREADS;
-        vkQueueWaitIdle(self->py_device->queue);
-        Py_END_ALLOW_THREADS;
-        Py_RETURN_NONE;
+        writes = *self->push_writes;
+        success = vulkan_Compute_fill_push_writes(self, py_sequences, writes);
     }
 
-    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+    // the items are referenced by the overrides, so releasing them here is safe
+    for (PyObject *py_sequence : py_sequences)
+    {
+        Py_XDECREF(py_sequence);
+    }
 
-    Py_RETURN_NONE;
+    return success;
 }
 
-static PyMethodDef vulkan_Resource_methods[] = {
-    {"upload", (PyCFunction)vulkan_Resource_upload, METH_VARARGS,
-     "Upload bytes to a GPU Resource"},
-    {"upload2d", (PyCFunction)vulkan_Resource_upload2d, METH_VARARGS,
-     "Upload bytes to a GPU Resource given pitch, width, height and pixel "
-     "size"},
-    {"upload_chunked", (PyCFunction)vulkan_Resource_upload_chunked, METH_VARARGS,
-     "Upload bytes to a GPU Resource with the given stride and a filler"},
-    {"readback", (PyCFunction)vulkan_Resource_readback, METH_VARARGS,
-     "Readback bytes from a GPU Resource"},
-    {"readback2d", (PyCFunction)vulkan_Resource_readback2d, METH_VARARGS,
-     "Readback bytes from a GPU Resource given pitch, width, height and "
-     "pixel "
-     "size"},
-    {"readback_to_buffer", (PyCFunction)vulkan_Resource_readback_to_buffer, METH_VARARGS,
-     "Readback into a buffer from a GPU Resource"},
-    {"copy_to", (PyCFunction)vulkan_Resource_copy_to, METH_VARARGS,
-     "Copy resource content to another resource"},
-    {"bind_tile", (PyCFunction)vulkan_Resource_bind_tile, METH_VARARGS, "Bind a sparse resource tile to a heap"},
-    {NULL, NULL, 0, NULL} /* Sentinel */
-};
+static void vulkan_Compute_bind(vulkan_Compute *self, const std::vector<VkWriteDescriptorSet> *push_writes)
+{
+    // the constants are written first, as wrapping the ring can split a batch
+    uint32_t constants_offset = 0;
+    if (!self->push_descriptors && self->constants_size > 0)
+    {
+        constants_offset = vulkan_Device_write_constants(self->py_device, self->constants->data(), self->constants_size);
+    }
 
-static PyObject *vulkan_Swapchain_present(vulkan_Swapchain *self, PyObject *args)
+    vkCmdBindPipeline(
+        self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, self->pipeline);
+
+    if (self->push_descriptors)
+    {
+#ifdef VK_KHR_push_descriptor
+        std::vector<VkWriteDescriptorSet> writes;
+        if (!push_writes)
+        {
+            // the resources passed at creation time are always valid
+            vulkan_Compute_get_push_writes(self, NULL, NULL, NULL, writes);
+            push_writes = &writes;
+        }
+        if (push_writes->size() > 0)
+        {
+            self->py_device->cmd_push_descriptor_set(self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                                                     self->pipeline_layout, 0, (uint32_t)push_writes->size(), push_writes->data());
+        }
+#endif
+        if (self->uses_bindless_heap)
+        {
+            vkCmdBindDescriptorSets(self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                                    self->pipeline_layout, VULKAN_BINDLESS_HEAP_SET, 1, &self->py_device->bindless_heap_set, 0, nullptr);
+        }
+        return;
+    }
+
+    VkDescriptorSet descriptor_sets[2] = {self->descriptor_set, self->py_device->bindless_heap_set};
+    vkCmdBindDescriptorSets(self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                            self->pipeline_layout, 0, self->uses_bindless_heap ? 2 : 1, descriptor_sets,
+                            self->constants_size > 0 ? 1 : 0, &constants_offset);
+}
+
+static PyObject *vulkan_Compute_dispatch(vulkan_Compute *self, COMPUSHADY_FASTCALL_ARGS)
 {
-    PyObject *py_resource;
-    uint32_t x;
-    uint32_t y;
-    if (!PyArg_ParseTuple(args, "OII", &py_resource, &x, &y))
+    static const char *kwlist[] = {"x", "y", "z", "push", "cbv", "srv", "uav", "constants", "wait", NULL};
+    PyObject *slots[9];
+    uint32_t x, y, z;
+    Py_buffer view = {};
+    Py_buffer constants_view = {};
+    if (!compushady_fastcall_parse("dispatch", kwlist, 3, slots, COMPUSHADY_FASTCALL_PASS) ||
+        !compushady_fastcall_uint32(slots[0], &x) ||
+        !compushady_fastcall_uint32(slots[1], &y) ||
+        !compushady_fastcall_uint32(slots[2], &z))
         return NULL;
 
-    int ret = PyObject_IsInstance(py_resource, (PyObject *)&vulkan_Resource_Type);
-    if (ret < 0)
+    // None is accepted for all of the optional arguments
+    for (uint32_t i = 3; i < 9; i++)
+    {
+        if (slots[i] == Py_None)
+        {
+            slots[i] = NULL;
+        }
+    }
+
+    // without waiting, the dispatch is tracked by the fence of its submission
+    int wait = 1;
+    if (slots[8] && (wait = PyObject_IsTrue(slots[8])) < 0)
+        return NULL;
+
+    if (!compushady_fastcall_buffer(slots[3], &view))
+        return NULL;
+
+    if (!compushady_fastcall_buffer(slots[7], &constants_view))
     {
+        PyBuffer_Release(&view);
         return NULL;
     }
-    else if (ret == 0)
+
+    PyObject *py_cbv = slots[4];
+    PyObject *py_srv = slots[5];
+    PyObject *py_uav = slots[6];
+
+    std::vector<VkWriteDescriptorSet> push_writes;
+    if (!vulkan_Compute_get_push_writes(self, py_cbv, py_srv, py_uav, push_writes))
+    {
+        PyBuffer_Release(&view);
+        PyBuffer_Release(&constants_view);
+        return NULL;
+    }
+
+    if (slots[7])
+    {
+        if (self->constants_size == 0)
+        {
+            PyBuffer_Release(&view);
+            PyBuffer_Release(&constants_view);
+            return PyErr_Format(PyExc_ValueError, "Compute pipeline has not been created with constants_size");
+        }
+        if ((uint64_t)constants_view.len > self->constants_size)
+        {
+            uint64_t size = constants_view.len;
+            PyBuffer_Release(&view);
+            PyBuffer_Release(&constants_view);
+            return PyErr_Format(PyExc_ValueError, "constants size (%llu) exceeds the Compute constants size (%u)", size, self->constants_size);
+        }
+        // the constants are retained for the dispatches not passing them
+        memcpy(self->constants->data(), constants_view.buf, constants_view.len);
+        PyBuffer_Release(&constants_view);
+    }
+
+    if (view.len > 0)
+    {
+        if (view.len > self->push_constant_size || (view.len % 4) != 0)
+        {
+            const uint32_t size = (uint32_t)view.len;
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError,
+                                "Invalid push constant size: %u, expected max %u with 4 bytes alignment", size, self->push_constant_size);
+        }
+    }
+
+    vulkan_Device_begin(self->py_device);
+
+    vulkan_Compute_bind(self, &push_writes);
+    if (view.len > 0)
     {
-        return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
+        vkCmdPushConstants(self->py_device->command_buffer, self->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, (uint32_t)view.len, view.buf);
     }
-    vulkan_Resource *src_resource = (vulkan_Resource *)py_resource;
-    if (!src_resource->image)
+    PyBuffer_Release(&view);
+    vkCmdDispatch(self->py_device->command_buffer, x, y, z);
+
+    VkResult result = wait ? vulkan_Device_submit_and_wait(self->py_device) : vulkan_Device_submit(self->py_device, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+    if (result == VK_SUCCESS)
     {
-        return PyErr_Format(PyExc_ValueError, "Expected a Texture object");
+        Py_RETURN_NONE;
     }
 
-    uint32_t index = 0;
-    VkResult result = vkAcquireNextImageKHR(self->py_device->device, self->swapchain, UINT64_MAX,
-                                            self->copy_semaphore, VK_NULL_HANDLE, &index);
-    if (result != VK_SUCCESS)
+    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
+}
+
+static PyObject *vulkan_Compute_dispatch_many(vulkan_Compute *self, PyObject *args)
+{
+    Py_buffer groups_view = {};
+    Py_buffer push_view = {};
+    if (!PyArg_ParseTuple(args, "y*y*", &groups_view, &push_view))
+        return NULL;
+
+    if (groups_view.len == 0 || (groups_view.len % (sizeof(uint32_t) * 3)) != 0)
     {
-        return PyErr_Format(PyExc_Exception, "unable to acquire next image from Swapchain");
+        PyBuffer_Release(&groups_view);
+        PyBuffer_Release(&push_view);
+        return PyErr_Format(PyExc_ValueError, "Invalid groups size: %zd, expected a non empty multiple of 12 bytes (3 uint32 per dispatch)", groups_view.len);
     }
 
-    x = Py_MIN(x, self->image_extent.width - 1);
-    y = Py_MIN(y, self->image_extent.height - 1);
-
-    VkCommandBufferBeginInfo begin_info = {};
-    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    const size_t dispatches = groups_view.len / (sizeof(uint32_t) * 3);
+    size_t push_stride = 0;
 
-    VkImageMemoryBarrier image_memory_barrier[2] = {};
-    image_memory_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    image_memory_barrier[0].image = self->images[index];
-    image_memory_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_memory_barrier[0].subresourceRange.levelCount = 1;
-    image_memory_barrier[0].subresourceRange.layerCount = 1;
-    image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    image_memory_barrier[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    image_memory_barrier[1].image = src_resource->image;
-    image_memory_barrier[1].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_memory_barrier[1].subresourceRange.levelCount = 1;
-    image_memory_barrier[1].subresourceRange.layerCount = 1;
-    image_memory_barrier[1].oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-    image_memory_barrier[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    if (push_view.len > 0)
+    {
+        push_stride = push_view.len / dispatches;
+        if (push_stride * dispatches != (size_t)push_view.len || push_stride > self->push_constant_size || (push_stride % 4) != 0)
+        {
+            PyBuffer_Release(&groups_view);
+            PyBuffer_Release(&push_view);
+            return PyErr_Format(PyExc_ValueError,
+                                "Invalid push constants size: %zd for %zu dispatches, expected max %u bytes per dispatch with 4 bytes alignment", push_view.len, dispatches, self->push_constant_size);
+        }
+    }
 
-    VkImageCopy image_copy = {};
-    image_copy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_copy.srcSubresource.layerCount = 1;
-    image_copy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    image_copy.dstSubresource.layerCount = 1;
-    image_copy.extent.width = Py_MIN(src_resource->image_extent.width, self->image_extent.width - x);
-    image_copy.extent.height = Py_MIN(src_resource->image_extent.height, self->image_extent.height - y);
-    image_copy.extent.depth = 1;
-    image_copy.dstOffset.x = x;
-    image_copy.dstOffset.y = y;
+    const uint32_t *groups = (const uint32_t *)groups_view.buf;
+    const uint8_t *push_constants = (const uint8_t *)push_view.buf;
 
-    vkBeginCommandBuffer(self->py_device->command_buffer, &begin_info);
-    vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
-    vkCmdCopyImage(self->py_device->command_buffer, src_resource->image,
-                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, self->images[index],
-                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
-    image_memory_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    image_memory_barrier[0].newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    image_memory_barrier[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    image_memory_barrier[1].newLayout = VK_IMAGE_LAYOUT_GENERAL;
-    vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, 0, 0, 0, 2, image_memory_barrier);
-    vkEndCommandBuffer(self->py_device->command_buffer);
+    vulkan_Device_begin(self->py_device);
 
-    VkPipelineStageFlags flags = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    VkSubmitInfo submit_info = {};
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.pCommandBuffers = &self->py_device->command_buffer;
-    submit_info.commandBufferCount = 1;
-    submit_info.pWaitSemaphores = &self->copy_semaphore;
-    submit_info.waitSemaphoreCount = 1;
-    submit_info.pWaitDstStageMask = &flags;
-    submit_info.signalSemaphoreCount = 1;
-    submit_info.pSignalSemaphores = &self->present_semaphore;
+    vulkan_Compute_bind(self, nullptr);
 
-    result = vkQueueSubmit(self->py_device->queue, 1, &submit_info, VK_NULL_HANDLE);
+    // each dispatch must see the writes of the previous one (like distinct dispatch() calls)
+    VkMemoryBarrier memory_barrier = {};
+    memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
 
-    if (result != VK_SUCCESS)
+    for (size_t i = 0; i < dispatches; i++)
     {
-        return PyErr_Format(PyExc_Exception, "unable to copy image to Swapchain: %d", result);
+        if (i > 0)
+        {
+            vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+        }
+        if (push_stride > 0)
+        {
+            vkCmdPushConstants(self->py_device->command_buffer, self->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, (uint32_t)push_stride, push_constants + (push_stride * i));
+        }
+        vkCmdDispatch(self->py_device->command_buffer, groups[i * 3], groups[i * 3 + 1], groups[i * 3 + 2]);
     }
 
-    VkPresentInfoKHR present_info = {};
-    present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    present_info.pSwapchains = &(self->swapchain);
-    present_info.swapchainCount = 1;
-    present_info.pImageIndices = &index;
-    present_info.waitSemaphoreCount = 1;
-    present_info.pWaitSemaphores = &(self->present_semaphore);
-    result = vkQueuePresentKHR(self->py_device->queue, &present_info);
+    PyBuffer_Release(&groups_view);
+    PyBuffer_Release(&push_view);
 
-    if (result == VK_SUCCESS)
+    if (vulkan_Device_submit_and_wait(self->py_device) == VK_SUCCESS)
     {
-        Py_BEGIN_ALLOW_THREADS;
-        vkQueueWaitIdle(self->py_device->queue);
-        Py_END_ALLOW_THREADS;
         Py_RETURN_NONE;
     }
 
-    return PyErr_Format(PyExc_Exception, "unable to present Swapchain: %d", result);
+    return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
 }
 
-static PyMethodDef vulkan_Swapchain_methods[] = {
-    {"present", (PyCFunction)vulkan_Swapchain_present, METH_VARARGS,
-     "Blit a texture resource to the Swapchain and present it"},
-    {NULL, NULL, 0, NULL} /* Sentinel */
-};
-
-static PyObject *vulkan_Compute_dispatch(vulkan_Compute *self, PyObject *args)
+static PyObject *vulkan_Compute_dispatch_indirect(vulkan_Compute *self, PyObject *args)
 {
-    uint32_t x, y, z;
+    PyObject *py_indirect_buffer;
+    uint32_t offset;
     Py_buffer view = {};
-    if (!PyArg_ParseTuple(args, "IIIy*", &x, &y, &z, &view))
+    if (!PyArg_ParseTuple(args, "OIy*", &py_indirect_buffer, &offset, &view))
         return NULL;
 
-    if (view.len > 0)
+    int ret = PyObject_IsInstance(py_indirect_buffer, (PyObject *)&vulkan_Resource_Type);
+    if (ret < 0)
     {
-        if (view.len > self->push_constant_size || (view.len % 4) != 0)
-        {
-            return PyErr_Format(PyExc_ValueError,
-                                "Invalid push constant size: %u, expected max %u with 4 bytes alignment", view.len, self->push_constant_size);
-        }
+        return NULL;
+    }
+    else if (ret == 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
     }
 
-    VkCommandBufferBeginInfo begin_info = {};
-    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    vkBeginCommandBuffer(self->py_device->command_buffer, &begin_info);
+    vulkan_Resource *py_resource = (vulkan_Resource *)py_indirect_buffer;
+    if (!py_resource->buffer)
+    {
+        return PyErr_Format(PyExc_ValueError, "Expected a Buffer object");
+    }
 
-    vkCmdBindPipeline(
-        self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, self->pipeline);
-    vkCmdBindDescriptorSets(self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE,
-                            self->pipeline_layout, 0, 1, &self->descriptor_set, 0, nullptr);
+    vulkan_Device_begin(self->py_device);
+
+    vulkan_Compute_bind(self, nullptr);
     if (view.len > 0)
     {
         vkCmdPushConstants(self->py_device->command_buffer, self->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, (uint32_t)view.len, view.buf);
     }
-    vkCmdDispatch(self->py_device->command_buffer, x, y, z);
-    vkEndCommandBuffer(self->py_device->command_buffer);
-
-    VkSubmitInfo submit_info = {};
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.pCommandBuffers = &self->py_device->command_buffer;
-    submit_info.commandBufferCount = 1;
+    vkCmdDispatchIndirect(self->py_device->command_buffer, py_resource->buffer, py_resource->buffer_offset + offset);
 
-    VkResult result = vkQueueSubmit(self->py_device->queue, 1, &submit_info, VK_NULL_HANDLE);
-
-    if (result == VK_SUCCESS)
+    if (vulkan_Device_submit_and_wait(self->py_device) == VK_SUCCESS)
     {
-        Py_BEGIN_ALLOW_THREADS;
-        vkQueueWaitIdle(self->py_device->queue);
-        Py_END_ALLOW_THREADS;
         Py_RETURN_NONE;
     }
 
     return PyErr_Format(PyExc_Exception, "unable to submit to Queue");
 }
 
-static PyObject *vulkan_Compute_dispatch_indirect(vulkan_Compute *self, PyObject *args)
+static PyObject *vulkan_Compute_dispatch_indirect_many(vulkan_Compute *self, PyObject *args)
 {
     PyObject *py_indirect_buffer;
-    uint32_t offset;
+    uint64_t offset;
+    uint32_t count;
+    uint32_t stride;
     Py_buffer view = {};
-    if (!PyArg_ParseTuple(args, "OIy*", &py_indirect_buffer, &offset, &view))
+    if (!PyArg_ParseTuple(args, "OKIIy*", &py_indirect_buffer, &offset, &count, &stride, &view))
         return NULL;
 
     int ret = PyObject_IsInstance(py_indirect_buffer, (PyObject *)&vulkan_Resource_Type);
     if (ret < 0)
     {
+        PyBuffer_Release(&view);
         return NULL;
     }
     else if (ret == 0)
     {
+        PyBuffer_Release(&view);
         return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
     }
 
     vulkan_Resource *py_resource = (vulkan_Resource *)py_indirect_buffer;
     if (!py_resource->buffer)
     {
+        PyBuffer_Release(&view);
         return PyErr_Format(PyExc_ValueError, "Expected a Buffer object");
     }
 
-    VkCommandBufferBeginInfo begin_info = {};
-    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    vkBeginCommandBuffer(self->py_device->command_buffer, &begin_info);
+    if (view.len > 0)
+    {
+        if (view.len > self->push_constant_size || (view.len % 4) != 0)
+        {
+            PyBuffer_Release(&view);
+            return PyErr_Format(PyExc_ValueError,
+                                "Invalid push constant size: %zd, expected max %u with 4 bytes alignment", view.len, self->push_constant_size);
+        }
+    }
 
-    vkCmdBindPipeline(
-        self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, self->pipeline);
-    vkCmdBindDescriptorSets(self->py_device->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE,
-                            self->pipeline_layout, 0, 1, &self->descriptor_set, 0, nullptr);
+    // VkDispatchIndirectCommand is 3 uint32
+    if (stride < sizeof(uint32_t) * 3 || (stride % 4) != 0 || (offset % 4) != 0)
+    {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError, "Invalid indirect stride (%u) or offset (%llu), stride must be at least 12 bytes and both must be 4 bytes aligned", stride, offset);
+    }
+
+    if (count == 0)
+    {
+        PyBuffer_Release(&view);
+        Py_RETURN_NONE;
+    }
+
+    if (offset + ((uint64_t)(count - 1) * stride) + (sizeof(uint32_t) * 3) > py_resource->size)
+    {
+        PyBuffer_Release(&view);
+        return PyErr_Format(PyExc_ValueError, "Indirect commands (count: %u stride: %u offset: %llu) are out of bounds (size: %llu)", count, stride, offset, py_resource->size);
+    }
+
+    vulkan_Device_begin(self->py_device);
+
+    vulkan_Compute_bind(self, nullptr);
     if (view.len > 0)
     {
         vkCmdPushConstants(self->py_device->command_buffer, self->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, (uint32_t)view.len, view.buf);
     }
-    vkCmdDispatchIndirect(self->py_device->command_buffer, py_resource->buffer, offset);
-    vkEndCommandBuffer(self->py_device->command_buffer);
 
-    VkSubmitInfo submit_info = {};
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.pCommandBuffers = &self->py_device->command_buffer;
-    submit_info.commandBufferCount = 1;
+    VkMemoryBarrier memory_barrier = {};
+    memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            vkCmdPipelineBarrier(self->py_device->command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+        }
+        vkCmdDispatchIndirect(self->py_device->command_buffer, py_resource->buffer, py_resource->buffer_offset + offset + ((uint64_t)i * stride));
+    }
 
-    VkResult result = vkQueueSubmit(self->py_device->queue, 1, &submit_info, VK_NULL_HANDLE);
+    PyBuffer_Release(&view);
 
-    if (result == VK_SUCCESS)
+    if (vulkan_Device_submit_and_wait(self->py_device) == VK_SUCCESS)
     {
-        Py_BEGIN_ALLOW_THREADS;
-        vkQueueWaitIdle(self->py_device->queue);
-        Py_END_ALLOW_THREADS;
         Py_RETURN_NONE;
     }
 
@@ -3649,6 +7116,11 @@ static PyObject *vulkan_Compute_bind_cbv(vulkan_Compute *self, PyObject *args)
         return PyErr_Format(PyExc_ValueError, "Expected a Buffer object");
     }
 
+    if (!vulkan_Resource_check_usage(py_cbv, 0))
+    {
+        return NULL;
+    }
+
     VkWriteDescriptorSet write_descriptor_set = {};
     write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     write_descriptor_set.descriptorCount = 1;
@@ -3695,6 +7167,11 @@ static PyObject *vulkan_Compute_bind_srv(vulkan_Compute *self, PyObject *args)
 
     vulkan_Resource *py_srv = (vulkan_Resource *)py_resource;
 
+    if (!vulkan_Resource_check_usage(py_srv, 1))
+    {
+        return NULL;
+    }
+
     VkWriteDescriptorSet write_descriptor_set = {};
     write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     write_descriptor_set.descriptorCount = 1;
@@ -3758,6 +7235,11 @@ static PyObject *vulkan_Compute_bind_uav(vulkan_Compute *self, PyObject *args)
 
     vulkan_Resource *py_uav = (vulkan_Resource *)py_resource;
 
+    if (!vulkan_Resource_check_usage(py_uav, 2))
+    {
+        return NULL;
+    }
+
     VkWriteDescriptorSet write_descriptor_set = {};
     write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     write_descriptor_set.descriptorCount = 1;
@@ -3779,7 +7261,7 @@ static PyObject *vulkan_Compute_bind_uav(vulkan_Compute *self, PyObject *args)
     }
     else
     {
-        write_descriptor_set.pImageInfo = &py_uav->descriptor_image_info;
+        write_descriptor_set.pImageInfo = &py_uav->descriptor_storage_image_info;
     }
     write_descriptor_set.dstSet = self->descriptor_set;
 
@@ -3792,14 +7274,160 @@ static PyObject *vulkan_Compute_bind_uav(vulkan_Compute *self, PyObject *args)
     Py_RETURN_NONE;
 }
 
+/*
+ * Binds a sequence of resources to consecutive slots (starting from start_index) of a Bindless Compute Pipeline
+ * (binding_base is 0 for CBVs, 1024 for SRVs and 2048 for UAVs) with a single vkUpdateDescriptorSets call.
+ */
+static PyObject *vulkan_Compute_bind_many(vulkan_Compute *self, PyObject *args, const uint32_t binding_base, PyObject *py_resources_list)
+{
+    uint32_t start_index;
+    PyObject *py_resources;
+    if (!PyArg_ParseTuple(args, "IO", &start_index, &py_resources))
+        return NULL;
+
+    if (self->bindless == 0)
+    {
+        return PyErr_Format(PyExc_ValueError, "Compute pipeline is not in bindless mode");
+    }
+
+    PyObject *py_sequence = PySequence_Fast(py_resources, "Expected a sequence of Resource objects");
+    if (!py_sequence)
+        return NULL;
+
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(py_sequence);
+    if (count == 0)
+    {
+        Py_DECREF(py_sequence);
+        Py_RETURN_NONE;
+    }
+
+    if ((uint64_t)start_index + count > self->bindless)
+    {
+        Py_DECREF(py_sequence);
+        return PyErr_Format(PyExc_ValueError, "Invalid bind range %u-%u (max: %u)", start_index, (uint32_t)(start_index + count - 1), self->bindless - 1);
+    }
+
+    std::vector<VkWriteDescriptorSet> write_descriptor_sets(count);
+
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        PyObject *py_item = PySequence_Fast_GET_ITEM(py_sequence, i);
+        const int ret = PyObject_IsInstance(py_item, (PyObject *)&vulkan_Resource_Type);
+        if (ret < 0)
+        {
+            Py_DECREF(py_sequence);
+            return NULL;
+        }
+        else if (ret == 0)
+        {
+            Py_DECREF(py_sequence);
+            return PyErr_Format(PyExc_ValueError, "Expected a Resource object");
+        }
+
+        vulkan_Resource *py_resource = (vulkan_Resource *)py_item;
+
+        if (!vulkan_Resource_check_usage(py_resource, binding_base / 1024))
+        {
+            Py_DECREF(py_sequence);
+            return NULL;
+        }
+
+        VkWriteDescriptorSet &write_descriptor_set = write_descriptor_sets[i];
+        write_descriptor_set = {};
+        write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_descriptor_set.descriptorCount = 1;
+        write_descriptor_set.dstBinding = binding_base + start_index + (uint32_t)i;
+        write_descriptor_set.dstSet = self->descriptor_set;
+
+        if (binding_base == 0)
+        {
+            if (!py_resource->buffer)
+            {
+                Py_DECREF(py_sequence);
+                return PyErr_Format(PyExc_ValueError, "Expected a Buffer object");
+            }
+            write_descriptor_set.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            write_descriptor_set.pBufferInfo = &py_resource->descriptor_buffer_info;
+            continue;
+        }
+
+        const bool is_srv = binding_base == 1024;
+        if (py_resource->buffer)
+        {
+            if (py_resource->buffer_view)
+            {
+                write_descriptor_set.descriptorType = is_srv ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+                write_descriptor_set.pTexelBufferView = &py_resource->buffer_view;
+            }
+            else
+            {
+                write_descriptor_set.descriptorType = is_srv ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write_descriptor_set.pBufferInfo = &py_resource->descriptor_buffer_info;
+            }
+        }
+        else
+        {
+            write_descriptor_set.descriptorType = is_srv ? VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            write_descriptor_set.pImageInfo = is_srv ? &py_resource->descriptor_image_info : &py_resource->descriptor_storage_image_info;
+        }
+    }
+
+    vkUpdateDescriptorSets(self->py_device->device, (uint32_t)write_descriptor_sets.size(),
+                           write_descriptor_sets.data(), 0, NULL);
+
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        PyObject *py_item = PySequence_Fast_GET_ITEM(py_sequence, i);
+        Py_INCREF(py_item);
+        PyList_SetItem(py_resources_list, start_index + i, py_item);
+    }
+
+    Py_DECREF(py_sequence);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *vulkan_Compute_bind_cbv_many(vulkan_Compute *self, PyObject *args)
+{
+    return vulkan_Compute_bind_many(self, args, 0, self->py_cbv_list);
+}
+
+static PyObject *vulkan_Compute_bind_srv_many(vulkan_Compute *self, PyObject *args)
+{
+    return vulkan_Compute_bind_many(self, args, 1024, self->py_srv_list);
+}
+
+static PyObject *vulkan_Compute_bind_uav_many(vulkan_Compute *self, PyObject *args)
+{
+    return vulkan_Compute_bind_many(self, args, 2048, self->py_uav_list);
+}
+
+static PyMemberDef vulkan_Compute_members[] = {
+    {"push_size", T_UINT, offsetof(vulkan_Compute, push_constant_size), 0, "compute push constants size"},
+    {"thread_group_size_x", T_UINT, offsetof(vulkan_Compute, thread_group_size_x), 0, "compute thread group size x"},
+    {"thread_group_size_y", T_UINT, offsetof(vulkan_Compute, thread_group_size_y), 0, "compute thread group size y"},
+    {"thread_group_size_z", T_UINT, offsetof(vulkan_Compute, thread_group_size_z), 0, "compute thread group size z"},
+    {"bindings", T_OBJECT_EX, offsetof(vulkan_Compute, py_bindings), 0, "bindings used by the compute shader"},
+    {"push_descriptors", T_BOOL, offsetof(vulkan_Compute, push_descriptors), READONLY,
+     "returns True if the resources can be passed to dispatch()"},
+    {NULL} /* Sentinel */
+};
+
 static PyMethodDef vulkan_Compute_methods[] = {
-    {"dispatch", (PyCFunction)vulkan_Compute_dispatch, METH_VARARGS,
+    {"dispatch", (PyCFunction)(void (*)(void))vulkan_Compute_dispatch, COMPUSHADY_METH_FASTCALL,
      "Execute a Compute Pipeline"},
+    {"dispatch_many", (PyCFunction)vulkan_Compute_dispatch_many, METH_VARARGS,
+     "Execute a Compute Pipeline multiple times with a single submission"},
     {"dispatch_indirect", (PyCFunction)vulkan_Compute_dispatch_indirect, METH_VARARGS,
      "Execute an Indirect Compute Pipeline"},
+    {"dispatch_indirect_many", (PyCFunction)vulkan_Compute_dispatch_indirect_many, METH_VARARGS,
+     "Execute an Indirect Compute Pipeline multiple times with a single submission"},
     {"bind_cbv", (PyCFunction)vulkan_Compute_bind_cbv, METH_VARARGS, "Bind a CBV to a Bindless Compute Pipeline"},
     {"bind_srv", (PyCFunction)vulkan_Compute_bind_srv, METH_VARARGS, "Bind an SRV to a Bindless Compute Pipeline"},
     {"bind_uav", (PyCFunction)vulkan_Compute_bind_uav, METH_VARARGS, "Bind an UAV to a Bindless Compute Pipeline"},
+    {"bind_cbv_many", (PyCFunction)vulkan_Compute_bind_cbv_many, METH_VARARGS, "Bind a sequence of CBVs to a Bindless Compute Pipeline"},
+    {"bind_srv_many", (PyCFunction)vulkan_Compute_bind_srv_many, METH_VARARGS, "Bind a sequence of SRVs to a Bindless Compute Pipeline"},
+    {"bind_uav_many", (PyCFunction)vulkan_Compute_bind_uav_many, METH_VARARGS, "Bind a sequence of UAVs to a Bindless Compute Pipeline"},
     {NULL, NULL, 0, NULL} /* Sentinel */
 };
 
@@ -3831,7 +7459,7 @@ PyMODINIT_FUNC PyInit_vulkan(void)
                                           &vulkan_Device_Type, vulkan_Device_members, vulkan_Device_methods,
                                           &vulkan_Resource_Type, vulkan_Resource_members, vulkan_Resource_methods,
                                           &vulkan_Swapchain_Type, vulkan_Swapchain_members, vulkan_Swapchain_methods,
-                                          &vulkan_Compute_Type, NULL, vulkan_Compute_methods,
+                                          &vulkan_Compute_Type, vulkan_Compute_members, vulkan_Compute_methods,
                                           &vulkan_Sampler_Type, NULL, NULL,
                                           &vulkan_Heap_Type, vulkan_Heap_members, NULL);
 
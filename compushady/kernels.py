@@ -0,0 +1,146 @@
+"""Built-in compute kernels used internally by compushady"""
+
+sources = {}
+
+sources[
+    "indirect_count_prologue"
+] = """
+Buffer<uint> args : register(t0);
+Buffer<uint> count : register(t1);
+RWBuffer<uint> commands : register(u0);
+
+struct PushConstants
+{
+    uint stride;
+    uint max_count;
+};
+
+[[vk::push_constant]]
+ConstantBuffer<PushConstants> push_constants;
+
+[numthreads(64, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID)
+{
+    if (tid.x >= push_constants.max_count)
+    {
+        return;
+    }
+    const uint base = tid.x * push_constants.stride;
+    const bool enabled = tid.x < count[0];
+    commands[tid.x * 3] = enabled ? args[base] : 0;
+    commands[tid.x * 3 + 1] = enabled ? args[base + 1] : 0;
+    commands[tid.x * 3 + 2] = enabled ? args[base + 2] : 0;
+}
+"""
+
+sources[
+    "lz4_decompress"
+] = """
+Buffer<uint> compressed : register(t0);
+// for each block: compressed offset, compressed size, decompressed offset (4 bytes aligned), decompressed size
+Buffer<uint> blocks : register(t1);
+RWBuffer<uint> output : register(u0);
+
+struct PushConstants
+{
+    uint num_blocks;
+};
+
+[[vk::push_constant]]
+ConstantBuffer<PushConstants> push_constants;
+
+uint read_byte(uint offset)
+{
+    return (compressed[offset >> 2] >> ((offset & 3) * 8)) & 0xFF;
+}
+
+uint read_output_byte(uint offset)
+{
+    return (output[offset >> 2] >> ((offset & 3) * 8)) & 0xFF;
+}
+
+void write_byte(uint offset, uint value)
+{
+    const uint shift = (offset & 3) * 8;
+    output[offset >> 2] = (output[offset >> 2] & ~(0xFFu << shift)) | (value << shift);
+}
+
+// every thread decodes a whole LZ4 block (blocks are independent and do not share output words)
+[numthreads(64, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID)
+{
+    if (tid.x >= push_constants.num_blocks)
+    {
+        return;
+    }
+
+    uint ip = blocks[tid.x * 4];
+    const uint ip_end = ip + blocks[tid.x * 4 + 1];
+    const uint op_start = blocks[tid.x * 4 + 2];
+    uint op = op_start;
+    const uint op_end = op + blocks[tid.x * 4 + 3];
+
+    while (ip < ip_end)
+    {
+        const uint token = read_byte(ip++);
+
+        uint literals = token >> 4;
+        if (literals == 15)
+        {
+            uint value = 255;
+            while (value == 255 && ip < ip_end)
+            {
+                value = read_byte(ip++);
+                literals += value;
+            }
+        }
+
+        for (uint i = 0; i < literals && ip < ip_end && op < op_end; i++)
+        {
+            write_byte(op++, read_byte(ip++));
+        }
+
+        // the last sequence contains only literals
+        if (ip + 2 > ip_end)
+        {
+            break;
+        }
+
+        const uint offset = read_byte(ip) | (read_byte(ip + 1) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op - op_start)
+        {
+            break;
+        }
+
+        uint match_length = token & 15;
+        if (match_length == 15)
+        {
+            uint value = 255;
+            while (value == 255 && ip < ip_end)
+            {
+                value = read_byte(ip++);
+                match_length += value;
+            }
+        }
+        match_length += 4;
+
+        // byte by byte copy, matches can overlap the output
+        uint match = op - offset;
+        for (uint j = 0; j < match_length && op < op_end; j++)
+        {
+            write_byte(op++, read_output_byte(match++));
+        }
+    }
+}
+"""
+
+_compiled = {}
+
+
+def get(name):
+    if name not in _compiled:
+        from compushady.shaders import hlsl
+
+        _compiled[name] = hlsl.compile(sources[name])
+    return _compiled[name]
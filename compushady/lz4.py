@@ -0,0 +1,207 @@
+"""LZ4 block compression, with the decompression running on the GPU"""
+
+import struct
+from . import Buffer, Compute, HEAP_UPLOAD, get_current_device
+from .formats import R32_UINT
+
+DEFAULT_BLOCK_SIZE = 65536
+
+# the last 5 bytes of a block are always literals and the last match must start
+# at least 12 bytes before the end of the block
+_LAST_LITERALS = 5
+_MATCH_LIMIT = 12
+_MIN_MATCH = 4
+_MAX_OFFSET = 65535
+
+
+def _write_length(output, length):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+    output.append(length)
+
+
+def _write_sequence(output, literals, offset=0, match_length=0):
+    literals_length = len(literals)
+    token = (literals_length if literals_length < 15 else 15) << 4
+    if offset:
+        match_length -= _MIN_MATCH
+        token |= match_length if match_length < 15 else 15
+    output.append(token)
+    if literals_length >= 15:
+        _write_length(output, literals_length - 15)
+    output += literals
+    if offset:
+        output += struct.pack("<H", offset)
+        if match_length >= 15:
+            _write_length(output, match_length - 15)
+
+
+def compress_block(data):
+    data = bytes(data)
+    size = len(data)
+    output = bytearray()
+    table = {}
+    anchor = 0
+    position = 0
+    while position < size - _MATCH_LIMIT:
+        sequence = data[position : position + _MIN_MATCH]
+        candidate = table.get(sequence)
+        table[sequence] = position
+        if candidate is None or position - candidate > _MAX_OFFSET:
+            position += 1
+            continue
+        match_length = _MIN_MATCH
+        while (
+            position + match_length < size - _LAST_LITERALS
+            and data[candidate + match_length] == data[position + match_length]
+        ):
+            match_length += 1
+        _write_sequence(
+            output, data[anchor:position], position - candidate, match_length
+        )
+        position += match_length
+        anchor = position
+    _write_sequence(output, data[anchor:])
+    return bytes(output)
+
+
+def decompress_block(data, size):
+    data = bytes(data)
+    output = bytearray()
+    position = 0
+    while position < len(data):
+        token = data[position]
+        position += 1
+        literals_length = token >> 4
+        if literals_length == 15:
+            value = 255
+            while value == 255:
+                value = data[position]
+                position += 1
+                literals_length += value
+        output += data[position : position + literals_length]
+        position += literals_length
+        if position >= len(data):
+            break
+        offset = data[position] | (data[position + 1] << 8)
+        position += 2
+        match_length = token & 15
+        if match_length == 15:
+            value = 255
+            while value == 255:
+                value = data[position]
+                position += 1
+                match_length += value
+        match_length += _MIN_MATCH
+        for i in range(0, match_length):
+            output.append(output[-offset])
+    return bytes(output[:size])
+
+
+def compress(data, block_size=DEFAULT_BLOCK_SIZE):
+    if block_size <= 0 or block_size % 4:
+        raise ValueError("block size must be a multiple of 4")
+    data = memoryview(data).cast("B")
+    payload = bytearray()
+    blocks = []
+    for offset in range(0, len(data), block_size):
+        block = data[offset : offset + block_size]
+        compressed = compress_block(block)
+        blocks.append((len(payload), len(compressed), offset, len(block)))
+        payload += compressed
+    return bytes(payload), blocks
+
+
+def decompress(payload, blocks):
+    # blocks can be in any order, so the whole output is allocated upfront
+    output = bytearray(max([offset + size for _, _, offset, size in blocks] + [0]))
+    for compressed_offset, compressed_size, offset, size in blocks:
+        if size == 0:
+            continue
+        block = decompress_block(
+            payload[compressed_offset : compressed_offset + compressed_size], size
+        )
+        if len(block) != size:
+            raise ValueError("corrupted block at offset {0}".format(compressed_offset))
+        output[offset : offset + size] = block
+    return bytes(output)
+
+
+class Decompressor:
+    def __init__(self, device=None):
+        self.device = device if device else get_current_device()
+        self.staging = None
+        self.compressed = None
+        self.blocks = None
+        self.blocks_staging = None
+        self.compute = None
+        self.destination = None
+
+    def _grow(self, buffer, size, heap_type=None):
+        size = (size + 3) & ~3
+        if buffer is not None and buffer.size >= size:
+            return buffer
+        if heap_type is not None:
+            return Buffer(size, heap_type, device=self.device)
+        return Buffer(size, format=R32_UINT, device=self.device)
+
+    def decompress(self, payload, blocks, destination):
+        """Decompresses the LZ4 blocks of payload (bytes-like or an UPLOAD Buffer) into a R32_UINT Buffer"""
+        num_blocks = len(blocks)
+        if num_blocks == 0:
+            return
+
+        if isinstance(payload, Buffer):
+            staging = payload
+            compressed_size = payload.size
+        else:
+            payload = memoryview(payload).cast("B")
+            compressed_size = payload.nbytes
+            self.staging = self._grow(self.staging, compressed_size, HEAP_UPLOAD)
+            self.staging.upload(payload)
+            staging = self.staging
+
+        for compressed_offset, size, offset, decompressed_size in blocks:
+            if compressed_offset + size > compressed_size:
+                raise ValueError("block out of the compressed payload")
+            if offset % 4:
+                raise ValueError("decompressed blocks must be 4 bytes aligned")
+            if offset + decompressed_size > destination.size:
+                raise ValueError("block out of the destination buffer")
+
+        compressed = self._grow(self.compressed, compressed_size)
+        blocks_size = num_blocks * 16
+        blocks_buffer = self._grow(self.blocks, blocks_size)
+        self.blocks_staging = self._grow(self.blocks_staging, blocks_size, HEAP_UPLOAD)
+
+        if (
+            self.compute is None
+            or compressed is not self.compressed
+            or blocks_buffer is not self.blocks
+            or destination is not self.destination
+        ):
+            from . import kernels
+
+            self.compute = Compute(
+                kernels.get("lz4_decompress"),
+                srv=[compressed, blocks_buffer],
+                uav=[destination],
+                push_size=4,
+                device=self.device,
+            )
+        self.compressed = compressed
+        self.blocks = blocks_buffer
+        self.destination = destination
+
+        self.blocks_staging.upload(
+            struct.pack(
+                "<{0}I".format(num_blocks * 4),
+                *[value for block in blocks for value in block]
+            )
+        )
+        staging.copy_to(compressed, size=compressed_size)
+        self.blocks_staging.copy_to(blocks_buffer, size=blocks_size)
+        self.compute.dispatch(
+            (num_blocks + 63) // 64, 1, 1, struct.pack("<I", num_blocks)
+        )
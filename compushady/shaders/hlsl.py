@@ -33,8 +33,16 @@ elif platform.system() == "Darwin":
     ctypes.CDLL(lib_path, ctypes.RTLD_GLOBAL)
 
 
-def compile(source, entry_point="main", target="cs_6_0"):
-    blob = dxc.compile(source, entry_point, get_backend().get_shader_binary_type(), target)
+# the Vulkan instance is created for 1.1, so SPIR-V 1.3 (required by the wave
+# intrinsics) is always targeted unless a different environment is requested
+def compile(source, entry_point="main", target="cs_6_0", target_env="vulkan1.1"):
+    blob = dxc.compile(
+        source,
+        entry_point,
+        get_backend().get_shader_binary_type(),
+        target,
+        *([target_env] if target_env else []),
+    )
     if get_backend().get_shader_binary_type() == SHADER_BINARY_TYPE_MSL:
         from compushady.backends import metal
 
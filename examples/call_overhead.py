@@ -0,0 +1,43 @@
+import timeit
+import compushady
+from compushady import Buffer, Compute, HEAP_UPLOAD, HEAP_READBACK
+from compushady.formats import R32_UINT
+from compushady.shaders import hlsl
+
+# measures the per-call cost (python wrappers, arguments parsing and submission) of the hot methods
+# (on Vulkan Buffer.upload and Buffer.readback are aliases of the handle methods)
+
+print('Using device', compushady.get_current_device().name,
+      'with backend', compushady.get_backend().name)
+
+upload = Buffer(16, HEAP_UPLOAD)
+readback = Buffer(16, HEAP_READBACK)
+target = Buffer(16, format=R32_UINT)
+
+shader = hlsl.compile("""
+RWBuffer<uint> target : register(u0);
+[numthreads(1, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID)
+{
+    target[tid.x] = tid.x;
+}
+""")
+compute = Compute(shader, uav=[target])
+
+data = b'\0' * 16
+
+benchmarks = (
+    ('Resource.upload', lambda: upload.upload(data)),
+    ('Resource.handle.upload', lambda: upload.handle.upload(data)),
+    ('Resource.readback', lambda: readback.readback(16)),
+    ('Resource.handle.readback', lambda: readback.handle.readback(16)),
+    ('Resource.copy_to', lambda: upload.copy_to(target)),
+    ('Resource.handle.copy_to', lambda: upload.handle.copy_to(target.handle)),
+    ('Compute.dispatch', lambda: compute.dispatch(1, 1, 1)),
+    ('Compute.handle.dispatch', lambda: compute.handle.dispatch(1, 1, 1, b'')),
+)
+
+for name, function in benchmarks:
+    number = 1000
+    best = min(timeit.repeat(function, number=number, repeat=5))
+    print('{0}: {1:.2f} us per call'.format(name, best / number * 1000000))
@@ -112,10 +112,17 @@ while not glfw.window_should_close(window):
 
     random.shuffle(heaps)
 
+    megatexture.bind_tiles(
+        [
+            (x, y, 0, heaps[y * megatexture.tiles_x + x])
+            for y in range(0, megatexture.tiles_y)
+            for x in range(0, megatexture.tiles_x)
+        ]
+    )
+
     for y in range(0, megatexture.tiles_y):
         for x in range(0, megatexture.tiles_x):
             tile = y * megatexture.tiles_x + x
-            megatexture.bind_tile(x, y, 0, heaps[tile])
             if heaps[tile]:
                 load_chunk_to_tile(
                     x * megatexture.tile_width, y * megatexture.tile_height
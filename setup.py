@@ -28,6 +28,20 @@ if is_mac:
 
 backends = []
 
+spirv_cross_reflection_sources = [
+    "compushady/backends/spirv_cross/{0}".format(source)
+    for source in [
+        "spirv_cross.cpp",
+        "spirv_cfg.cpp",
+        "spirv_cross_parsed_ir.cpp",
+        "spirv_parser.cpp",
+    ]
+]
+
+spirv_cross_sources = spirv_cross_reflection_sources + [
+    "compushady/backends/spirv_cross/spirv_glsl.cpp"
+]
+
 if build_vulkan:
     backends.append(
         Extension(
@@ -39,10 +53,13 @@ if build_vulkan:
             sources=[
                 "compushady/backends/vulkan.cpp",
                 "compushady/backends/common.cpp",
-            ],
-            extra_compile_args=["-std=c++14"] if not is_windows else [],
+            ]
+            + spirv_cross_reflection_sources,
+            extra_compile_args=["-std=c++14", "-pthread"] if not is_windows else [],
             extra_link_args=(
-                ["-Wl,-rpath,{0}".format(vulkan_library_dirs[0])] if is_mac else []
+                ["-Wl,-rpath,{0}".format(vulkan_library_dirs[0])]
+                if is_mac
+                else ["-pthread"] if not is_windows else []
             ),
         )
     )
@@ -73,17 +90,6 @@ if is_mac:
         )
     )
 
-spirv_cross_sources = [
-    "compushady/backends/spirv_cross/{0}".format(source)
-    for source in [
-        "spirv_cross.cpp",
-        "spirv_cfg.cpp",
-        "spirv_cross_parsed_ir.cpp",
-        "spirv_parser.cpp",
-        "spirv_glsl.cpp",
-    ]
-]
-
 backends.append(
     Extension(
         "compushady.backends.dxc",
@@ -95,7 +101,8 @@ backends.append(
             "compushady/backends/spirv_cross/spirv_msl.cpp",
         ]
         + spirv_cross_sources,
-        extra_compile_args=["-std=c++14"] if not is_windows else [],
+        extra_compile_args=["-std=c++14", "-pthread"] if not is_windows else [],
+        extra_link_args=["-pthread"] if not is_windows else [],
     )
 )
 
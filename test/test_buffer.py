@@ -1,6 +1,7 @@
 import unittest
 from compushady import (
     Buffer,
+    Compute,
     Heap,
     HEAP_DEFAULT,
     HEAP_UPLOAD,
@@ -8,8 +9,16 @@ from compushady import (
     BufferException,
     get_current_device,
 )
+from compushady.formats import R32_UINT
+from compushady.shaders import hlsl
 import compushady.config
 import platform
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
 
 compushady.config.set_debug(True)
 
@@ -128,3 +137,272 @@ class BufferTests(unittest.TestCase):
 
         b0.copy_to(b_readback, size=4, src_offset=0)
         self.assertEqual(b_readback.readback(4), b"\xff\xee\xdd\xaa")
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "buffer device address is supported only on Vulkan",
+    )
+    def test_device_address(self):
+        b0 = Buffer(64)
+        # the device is initialized lazily, its features are known only after the first resource
+        if not get_current_device().supports_buffer_device_address:
+            self.skipTest("buffer device address is not supported by the device")
+        b1 = Buffer(64, HEAP_UPLOAD)
+        heap = Heap(HEAP_DEFAULT, 1024 * 1024)
+        b2 = Buffer(64, heap=heap)
+        self.assertIsNotNone(b0.device_address)
+        self.assertIsNotNone(b1.device_address)
+        self.assertIsNotNone(b2.device_address)
+        self.assertNotEqual(b0.device_address, b1.device_address)
+        self.assertNotEqual(b0.device_address, b2.device_address)
+
+        # the shader dereferences the address passed in a constant buffer
+        b1.upload(struct.pack("<II", 0xDEADBEEF, 0xCAFEBABE))
+        b1.copy_to(b0)
+        b_params = Buffer(16)
+        b1.upload(struct.pack("<Q", b0.device_address))
+        b1.copy_to(b_params, size=8)
+        b_output = Buffer(4, format=R32_UINT)
+        b_readback = Buffer(4, HEAP_READBACK)
+        shader = hlsl.compile(
+            """
+        struct Params
+        {
+            uint64_t address;
+        };
+        ConstantBuffer<Params> params : register(b0);
+        RWBuffer<uint> output : register(u0);
+        [numthreads(1, 1, 1)]
+        void main()
+        {
+            output[0] = vk::RawBufferLoad<uint>(params.address + 4);
+        }
+        """
+        )
+        compute = Compute(shader, cbv=[b_params], uav=[b_output])
+        compute.dispatch(1, 1, 1)
+        b_output.copy_to(b_readback)
+        self.assertEqual(struct.unpack("<I", b_readback.readback())[0], 0xCAFEBABE)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "features negotiation is supported only on Vulkan",
+    )
+    def test_features(self):
+        current_device = get_current_device()
+        self.assertIn("robust_buffer_access", current_device.features)
+        self.assertIn("shader_float16", current_device.features)
+        for supported in current_device.features.values():
+            self.assertIsInstance(supported, bool)
+        self.assertRaises(ValueError, current_device.request_features, ["not_a_feature"])
+        Buffer(8, device=current_device)
+        self.assertRaises(
+            ValueError, current_device.disable_features, ["shader_int64"]
+        )
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "features negotiation is supported only on Vulkan",
+    )
+    def test_features_negotiation(self):
+        # changing features requires a device not initialized yet: the
+        # negotiation runs in a new process, so a single adapter is enough and
+        # no second logical device is created on it
+        script = """
+import compushady
+from compushady import Buffer, HEAP_UPLOAD, HEAP_READBACK
+
+device = compushady.get_current_device()
+device.disable_features(["robust_buffer_access"])
+device.request_features(
+    [
+        name
+        for name, value in device.features.items()
+        if value and name != "robust_buffer_access"
+    ]
+)
+try:
+    device.request_features(["not_a_feature"])
+except ValueError:
+    pass
+else:
+    raise AssertionError("unknown feature accepted")
+b0 = Buffer(8, HEAP_UPLOAD)
+b1 = Buffer(8, HEAP_READBACK)
+b0.upload(b"hello!!!")
+b0.copy_to(b1)
+assert b1.readback() == b"hello!!!"
+try:
+    device.disable_features(["shader_int64"])
+except ValueError:
+    pass
+else:
+    raise AssertionError("features changed after the initialization")
+"""
+        env = dict(os.environ)
+        env["PYTHONPATH"] = os.pathsep.join(sys.path)
+        result = subprocess.run(
+            [sys.executable, "-c", script],
+            env=env,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+        )
+        self.assertEqual(result.returncode, 0, result.stdout.decode(errors="replace"))
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "keyword arguments on handles are supported only on Vulkan",
+    )
+    def test_handle_keywords(self):
+        b0 = Buffer(8, HEAP_UPLOAD)
+        b1 = Buffer(8, HEAP_READBACK)
+        b0.handle.upload(b"\x01\x02", offset=2)
+        b0.handle.upload(data=b"\x03", offset=4)
+        b0.handle.copy_to(b1.handle, size=4, src_offset=2, dst_offset=0)
+        self.assertEqual(b1.handle.readback(buffer_or_size=3), b"\x01\x02\x03")
+        self.assertEqual(b1.handle.readback(offset=1, buffer_or_size=2), b"\x02\x03")
+        self.assertRaises(TypeError, b0.handle.upload)
+        self.assertRaises(TypeError, b0.handle.upload, b"\x00", offset=0, size=1)
+        self.assertRaises(TypeError, b0.handle.upload, b"\x00", data=b"\x00")
+        self.assertRaises(TypeError, b0.handle.upload, "string")
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "wrappers are aliased to the handles only on Vulkan",
+    )
+    def test_aliased_wrappers(self):
+        b0 = Buffer(8, HEAP_UPLOAD)
+        b1 = Buffer(8, HEAP_READBACK)
+        self.assertEqual(b0.upload, b0.handle.upload)
+        self.assertEqual(b1.readback, b1.handle.readback)
+        b0.upload(b"\x01\x02\x03\x04", 4)
+        b0.copy_to(b1)
+        self.assertEqual(b1.readback(4, 4), b"\x01\x02\x03\x04")
+        data = bytearray(4)
+        self.assertIsNone(b1.readback(data, 4))
+        self.assertEqual(data, b"\x01\x02\x03\x04")
+        self.assertRaises(ValueError, b1.readback, data, 16)
+        # the keywords of the wrappers are accepted too
+        self.assertEqual(b1.readback(buffer_or_size=2, offset=5), b"\x02\x03")
+        data = bytearray(2)
+        self.assertIsNone(b1.readback(buffer_or_size=data, offset=6))
+        self.assertEqual(data, b"\x03\x04")
+        b0.upload(data=b"\x05", offset=0)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "buffer views are supported only on Vulkan",
+    )
+    def test_view(self):
+        b0 = Buffer(1024, HEAP_UPLOAD)
+        b1 = Buffer(1024, HEAP_READBACK)
+        v0 = b0.view(256, 4)
+        v1 = b1.view(512)
+        self.assertEqual(v0.size, 4)
+        self.assertEqual(v1.size, 512)
+        v0.upload(b"\x01\x02\x03\x04")
+        self.assertEqual(b0.readback(4, 256), b"\x01\x02\x03\x04")
+        v0.copy_to(v1, dst_offset=4)
+        self.assertEqual(b1.readback(8, 512), b"\x00" * 4 + b"\x01\x02\x03\x04")
+        self.assertEqual(v1.view(0, 8).readback(8), b1.readback(8, 512))
+        self.assertRaises(ValueError, b0.view, 1020, 8)
+        self.assertRaises(ValueError, b0.view, 2048)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "buffer recycling is supported only on Vulkan",
+    )
+    def test_buffer_cache(self):
+        device = get_current_device()
+        b0 = Buffer(1000, HEAP_UPLOAD)
+        del b0
+        self.assertGreater(device.buffer_cache_size, 0)
+        hits = device.buffer_cache_hits
+        b1 = Buffer(1000, HEAP_UPLOAD)
+        self.assertEqual(device.buffer_cache_hits, hits + 1)
+        self.assertEqual(b1.size, 1000)
+        b1.upload(b"\x01" * 1000)
+        b2 = Buffer(1000, HEAP_READBACK)
+        b1.copy_to(b2)
+        self.assertEqual(b2.readback(), b"\x01" * 1000)
+        del b1
+        del b2
+        device.empty_cache()
+        self.assertEqual(device.buffer_cache_size, 0)
+        # the counters are maintained by the device
+        self.assertRaises(AttributeError, setattr, device, "buffer_cache_size", 0)
+        self.assertRaises(AttributeError, setattr, device, "buffer_cache_hits", 0)
+
+    def test_file_transfer(self):
+        data = bytes(range(0, 256)) * 16
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "data.bin")
+            with open(path, "wb") as f:
+                f.write(data)
+            b0 = Buffer(len(data), HEAP_UPLOAD)
+            b1 = Buffer(len(data), HEAP_READBACK)
+            b0.upload_file(path)
+            b0.copy_to(b1)
+            self.assertEqual(b1.readback(), data)
+            b0.upload_file(path, file_offset=16, size=8, dst_offset=4)
+            b0.copy_to(b1)
+            self.assertEqual(b1.readback(12), data[0:4] + data[16:24])
+            output = os.path.join(directory, "output.bin")
+            b1.readback_to_file(output)
+            b1.readback_to_file(output, file_offset=len(data), size=4, src_offset=4)
+            with open(output, "rb") as f:
+                self.assertEqual(f.read(), b1.readback() + data[16:20])
+            self.assertRaises(ValueError, b0.upload_file, path, 0, len(data), 1)
+
+    def test_file_transfer_big(self):
+        # bigger than two 16MB slices, so multiple threads are used, with
+        # offsets and size not aligned to the pages
+        size = 33 * 1024 * 1024 + 4099
+        data = os.urandom(size + 1237)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "data.bin")
+            with open(path, "wb") as f:
+                f.write(data)
+            b0 = Buffer(size + 3, HEAP_UPLOAD)
+            b1 = Buffer(size + 3, HEAP_READBACK)
+            b0.upload_file(path, file_offset=1237, size=size, dst_offset=3)
+            b0.copy_to(b1)
+            self.assertEqual(b1.readback(size, 3), data[1237:])
+            output = os.path.join(directory, "output.bin")
+            b1.readback_to_file(output, file_offset=5, size=size - 1, src_offset=4)
+            with open(output, "rb") as f:
+                self.assertEqual(f.read(), b"\0" * 5 + data[1238:])
+            if compushady.get_backend().name == "vulkan":
+                # offset + size wraps around
+                self.assertRaises(
+                    ValueError, b0.handle.upload_file, 0, 0, 2**64 - 1, 16
+                )
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "heap mappings are shared only on Vulkan",
+    )
+    def test_file_transfer_threads(self):
+        # buffers of the same heap share the VkDeviceMemory mapped by the transfers
+        size = 17 * 1024 * 1024
+        heap = Heap(HEAP_UPLOAD, size * 4)
+        buffers = [
+            Buffer(size, HEAP_UPLOAD, heap=heap, heap_offset=size * i)
+            for i in range(0, 4)
+        ]
+        with tempfile.TemporaryDirectory() as directory:
+            paths = []
+            for i in range(0, 4):
+                paths.append(os.path.join(directory, "data{0}.bin".format(i)))
+                with open(paths[-1], "wb") as f:
+                    f.write(bytes([i + 1]) * size)
+            threads = [
+                threading.Thread(target=buffer.upload_file, args=(path,))
+                for buffer, path in zip(buffers, paths)
+            ]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        for i, buffer in enumerate(buffers):
+            self.assertEqual(buffer.readback(16, size - 16), bytes([i + 1]) * 16)
@@ -1,7 +1,15 @@
 import numpy
 import struct
 import unittest
-from compushady import Buffer, Compute, HEAP_UPLOAD, HEAP_READBACK, Texture2D, Texture3D
+from compushady import (
+    Buffer,
+    Compute,
+    HEAP_UPLOAD,
+    HEAP_READBACK,
+    Texture2D,
+    Texture3D,
+    StreamProcessor,
+)
 from compushady.shaders import hlsl
 from compushady.formats import (
     R32G32_FLOAT,
@@ -11,6 +19,7 @@ from compushady.formats import (
 )
 import compushady.config
 import platform
+import time
 
 compushady.config.set_debug(True)
 
@@ -264,6 +273,64 @@ class ComputeTests(unittest.TestCase):
             readback_buffer.readback(2 * 3 * 4 * 4), struct.pack("<24I", *range(0, 24))
         )
 
+    def _indirect_counter(self, indirect_data, output_size):
+        staging_buffer = Buffer(len(indirect_data), HEAP_UPLOAD)
+        staging_buffer.upload(indirect_data)
+        indirect_buffer = Buffer(len(indirect_data), format=R32_UINT)
+        staging_buffer.copy_to(indirect_buffer)
+        output_buffer = Buffer(output_size, format=R32_UINT)
+        zero = Buffer(output_size, HEAP_UPLOAD)
+        zero.upload(bytes(output_size))
+        zero.copy_to(output_buffer)
+        compute = Compute(
+            hlsl.compile(
+                """
+        RWBuffer<uint> output;
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            output[tid.x] += 1;
+        }
+        """
+            ),
+            uav=[output_buffer],
+        )
+        return indirect_buffer, output_buffer, compute
+
+    def test_indirect_many(self):
+        indirect_buffer, output_buffer, compute = self._indirect_counter(
+            struct.pack("<12I", 0, 0, 0, 0, 2, 1, 1, 0, 3, 1, 1, 0), 4 * 4
+        )
+        compute.dispatch_indirect_many(indirect_buffer, 16, 2, 16)
+        readback_buffer = Buffer(output_buffer.size, HEAP_READBACK)
+        output_buffer.copy_to(readback_buffer)
+        self.assertEqual(struct.unpack("<4I", readback_buffer.readback()), (2, 2, 1, 0))
+
+    def test_indirect_count(self):
+        indirect_buffer, output_buffer, compute = self._indirect_counter(
+            struct.pack("<12I", 1, 1, 1, 2, 1, 1, 3, 1, 1, 4, 1, 1), 4 * 4
+        )
+        count_staging_buffer = Buffer(8, HEAP_UPLOAD)
+        count_staging_buffer.upload(struct.pack("<II", 0xFFFF, 2))
+        count_buffer = Buffer(8, format=R32_UINT)
+        count_staging_buffer.copy_to(count_buffer)
+        compute.dispatch_indirect_count(indirect_buffer, count_buffer, 4, count_offset=4)
+        readback_buffer = Buffer(output_buffer.size, HEAP_READBACK)
+        output_buffer.copy_to(readback_buffer)
+        self.assertEqual(struct.unpack("<4I", readback_buffer.readback()), (2, 1, 0, 0))
+        if compushady.get_backend().name == "vulkan":
+            # the copies, the prologue and the dispatches are a single submission
+            serial = compute.device.submitted_serial
+            compute.dispatch_indirect_count(
+                indirect_buffer, count_buffer, 4, count_offset=4
+            )
+            self.assertEqual(compute.device.submitted_serial, serial + 1)
+            output_buffer.copy_to(readback_buffer)
+            self.assertEqual(
+                struct.unpack("<4I", readback_buffer.readback()), (4, 2, 0, 0)
+            )
+
     def test_push(self):
         b0 = Buffer(32, format=R32G32B32A32_UINT)
         b1 = Buffer(b0.size, HEAP_READBACK)
@@ -296,6 +363,171 @@ class ComputeTests(unittest.TestCase):
             (100, 100, 100, 100, 200, 200, 200, 200),
         )
 
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan", "reflection is available only on Vulkan"
+    )
+    def test_reflection(self):
+        b0 = Buffer(64, format=R32_UINT)
+        b1 = Buffer(b0.size, HEAP_READBACK)
+        unused = Buffer(16, format=R32_UINT)
+        shader = hlsl.compile(
+            """
+        RWBuffer<uint> unused : register(u0);
+        RWBuffer<uint> buffer : register(u1);
+
+        struct PushConstants
+        {
+            uint value;
+        };
+
+        [[vk::push_constant]]
+        ConstantBuffer<PushConstants> push_constants;
+
+        [numthreads(4, 2, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            buffer[tid.y * 8 + tid.x] = push_constants.value;
+        }
+        """
+        )
+        compute = Compute(shader, uav=[unused, b0])
+        self.assertEqual(compute.thread_group_size, (4, 2, 1))
+        self.assertEqual(compute.bindings, (2049,))
+        self.assertEqual(compute.handle.push_size, 4)
+        compute.dispatch_threads(6, 2, push=struct.pack("<I", 17))
+        b0.copy_to(b1)
+        self.assertEqual(struct.unpack("16I", b1.readback()), (17,) * 16)
+
+    def test_create_async(self):
+        shader = hlsl.compile(
+            """
+        RWBuffer<uint> target : register(u0);
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            target[tid.x] = tid.x * 2;
+        }
+        """
+        )
+        target = Buffer(4 * 4, format=R32_UINT)
+        b_readback = Buffer(target.size, HEAP_READBACK)
+        futures = [Compute.create_async(shader, uav=[target]) for i in range(0, 4)]
+        for future in futures:
+            compute = future.result()
+            compute.dispatch(4, 1, 1)
+        target.copy_to(b_readback)
+        self.assertEqual(struct.unpack("<4I", b_readback.readback()), (0, 2, 4, 6))
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "compute limits are exposed only on Vulkan",
+    )
+    def test_subgroup_size(self):
+        device = compushady.get_current_device()
+        self.assertGreater(device.subgroup_size, 0)
+        self.assertGreater(device.max_compute_work_group_invocations, 0)
+        self.assertGreater(device.max_compute_work_group_count_x, 0)
+        self.assertGreater(device.max_compute_shared_memory_size, 0)
+        self.assertIn("basic", device.subgroup_operations)
+        self.assertLessEqual(device.min_subgroup_size, device.subgroup_size)
+        self.assertGreaterEqual(device.max_subgroup_size, device.subgroup_size)
+        b0 = Buffer(4, format=R32_UINT)
+        b1 = Buffer(4, HEAP_READBACK)
+        # wave intrinsics are compiled for vulkan1.1 (SPIR-V 1.3)
+        shader = hlsl.compile(
+            """
+        RWBuffer<uint> buffer : register(u0);
+        [numthreads(1, 1, 1)]
+        void main()
+        {
+            buffer[0] = WaveGetLaneCount();
+        }
+        """
+        )
+        compute = Compute(shader, uav=[b0])
+        compute.dispatch(1, 1, 1)
+        b0.copy_to(b1)
+        lane_count = struct.unpack("I", b1.readback(4))[0]
+        self.assertGreaterEqual(lane_count, device.min_subgroup_size)
+        self.assertLessEqual(lane_count, device.max_subgroup_size)
+        if not device.supports_subgroup_size_control:
+            self.skipTest("subgroup size control is not supported by the device")
+        compute = Compute(shader, uav=[b0], subgroup_size=device.max_subgroup_size)
+        compute.dispatch(1, 1, 1)
+        b0.copy_to(b1)
+        self.assertEqual(struct.unpack("I", b1.readback(4))[0], device.max_subgroup_size)
+        self.assertRaises(
+            ValueError,
+            Compute,
+            shader,
+            uav=[b0],
+            subgroup_size=device.max_subgroup_size * 2,
+        )
+
+    def test_dispatch_many(self):
+        b0 = Buffer(4 * 8, format=R32_UINT)
+        b1 = Buffer(b0.size, HEAP_READBACK)
+        zero = Buffer(b0.size, HEAP_UPLOAD)
+        zero.upload(bytes(b0.size))
+        zero.copy_to(b0)
+        shader = hlsl.compile(
+            """
+        RWBuffer<uint> buffer : register(u0);
+
+        struct PushConstants
+        {
+            uint offset;
+            uint value;
+        };
+
+        [[vk::push_constant]]
+        ConstantBuffer<PushConstants> push_constants;
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            buffer[push_constants.offset + tid.x] += push_constants.value;
+        }
+        """
+        )
+        compute = Compute(shader, uav=[b0], push_size=8)
+        compute.dispatch_many(
+            [(2, 1, 1), (4, 1, 1), (1, 1, 1), (8, 1, 1)],
+            [
+                struct.pack("<II", 0, 1),
+                struct.pack("<II", 2, 10),
+                struct.pack("<II", 7, 100),
+                struct.pack("<II", 0, 1000),
+            ],
+        )
+        b0.copy_to(b1)
+        self.assertEqual(
+            struct.unpack("8I", b1.readback(32)),
+            (1001, 1001, 1010, 1010, 1010, 1010, 1000, 1100),
+        )
+
+    def test_dispatch_many_numpy(self):
+        b0 = Buffer(4 * 4, format=R32_UINT)
+        b1 = Buffer(b0.size, HEAP_READBACK)
+        zero = Buffer(b0.size, HEAP_UPLOAD)
+        zero.upload(bytes(b0.size))
+        zero.copy_to(b0)
+        shader = hlsl.compile(
+            """
+        RWBuffer<uint> buffer : register(u0);
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            buffer[tid.x] += 1;
+        }
+        """
+        )
+        compute = Compute(shader, uav=[b0])
+        compute.dispatch_many(numpy.array([[4, 1, 1], [3, 1, 1], [1, 1, 1]]))
+        b0.copy_to(b1)
+        self.assertEqual(struct.unpack("4I", b1.readback(16)), (3, 2, 2, 1))
+
     def test_bindless(self):
         try:
             shader = hlsl.compile(
@@ -336,6 +568,216 @@ class ComputeTests(unittest.TestCase):
             struct.unpack("<64I", b_readback.readback(4 * 64)), tuple(range(0, 64))
         )
 
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "bindless heap is supported only on Vulkan",
+    )
+    def test_bindless_heap(self):
+        b_upload = Buffer(4, HEAP_UPLOAD)
+        if not compushady.get_current_device().supports_bindless:
+            self.skipTest("bindless not supported")
+
+        shader = hlsl.compile(
+            """
+        [[vk::binding(1, 1)]] Buffer<uint> srv_heap[];
+        [[vk::binding(2, 1)]] RWBuffer<uint> uav_heap[];
+
+        struct Indices
+        {
+            uint sources[8];
+            uint target;
+        };
+        [[vk::push_constant]] ConstantBuffer<Indices> indices;
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            uav_heap[indices.target][tid.x] = srv_heap[indices.sources[tid.x]][0];
+        }
+        """
+        )
+
+        compute = Compute(shader)
+        compute2 = Compute(shader)
+
+        b_output = Buffer(4 * 8, format=R32_UINT)
+        b_readback = Buffer(b_output.size, HEAP_READBACK)
+
+        sources = []
+        for i in range(0, 8):
+            b = Buffer(4, format=R32_UINT)
+            b_upload.upload(struct.pack("<I", i * 2))
+            b_upload.copy_to(b)
+            sources.append(b)
+
+        indices = [b.bindless_index for b in sources]
+        self.assertEqual(len(set(indices)), 8)
+        self.assertEqual(indices[0], sources[0].bindless_index)
+
+        push = struct.pack("<9I", *indices, b_output.bindless_index)
+        compute.dispatch(8, 1, 1, push)
+        b_output.copy_to(b_readback)
+        self.assertEqual(
+            struct.unpack("<8I", b_readback.readback(4 * 8)), tuple(range(0, 16, 2))
+        )
+
+        push = struct.pack("<9I", *reversed(indices), b_output.bindless_index)
+        compute2.dispatch(8, 1, 1, push)
+        b_output.copy_to(b_readback)
+        self.assertEqual(
+            struct.unpack("<8I", b_readback.readback(4 * 8)),
+            tuple(reversed(range(0, 16, 2))),
+        )
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "push descriptors are supported only on Vulkan",
+    )
+    def test_push_descriptors(self):
+        b_upload = Buffer(4, HEAP_UPLOAD)
+        if not compushady.get_current_device().supports_push_descriptors:
+            self.skipTest("push descriptors not supported")
+
+        shader = hlsl.compile(
+            """
+        Buffer<uint> source : register(t0);
+        RWBuffer<uint> target : register(u0);
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            target[tid.x] = source[0] + tid.x;
+        }
+        """
+        )
+
+        sources = []
+        for i in range(0, 2):
+            b = Buffer(4, format=R32_UINT)
+            b_upload.upload(struct.pack("<I", (i + 1) * 100))
+            b_upload.copy_to(b)
+            sources.append(b)
+        targets = [Buffer(4 * 4, format=R32_UINT) for i in range(0, 2)]
+        b_readback = Buffer(4 * 4, HEAP_READBACK)
+
+        compute = Compute(
+            shader, srv=[sources[0]], uav=[targets[0]], push_descriptors=True
+        )
+        self.assertTrue(compute.handle.push_descriptors)
+        compute.dispatch(4, 1, 1)
+        compute.dispatch(4, 1, 1, srv=[sources[1]], uav=[targets[1]])
+        targets[0].copy_to(b_readback)
+        self.assertEqual(struct.unpack("<4I", b_readback.readback()), (100, 101, 102, 103))
+        targets[1].copy_to(b_readback)
+        self.assertEqual(struct.unpack("<4I", b_readback.readback()), (200, 201, 202, 203))
+
+        compute.dispatch(4, 1, 1, srv=[None], uav=[targets[1]])
+        targets[1].copy_to(b_readback)
+        self.assertEqual(struct.unpack("<4I", b_readback.readback()), (100, 101, 102, 103))
+
+        self.assertRaises(
+            ValueError, compute.dispatch, 1, 1, 1, srv=[Buffer(4)], uav=[targets[1]]
+        )
+        self.assertRaises(
+            ValueError,
+            Compute(shader, srv=[sources[0]], uav=[targets[0]]).dispatch,
+            1,
+            1,
+            1,
+            srv=[sources[1]],
+        )
+
+    @unittest.skipIf(
+        compushady.get_backend().name == "vulkan",
+        "push descriptors are supported on Vulkan",
+    )
+    def test_push_descriptors_unsupported(self):
+        source = Buffer(4, format=R32_UINT)
+        target = Buffer(4, format=R32_UINT)
+        shader = hlsl.compile(
+            """
+        Buffer<uint> source : register(t0);
+        RWBuffer<uint> target : register(u0);
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            target[tid.x] = source[tid.x];
+        }
+        """
+        )
+        self.assertRaises(
+            ValueError,
+            Compute,
+            shader,
+            srv=[source],
+            uav=[target],
+            push_descriptors=True,
+        )
+        compute = Compute(shader, srv=[source], uav=[target])
+        self.assertRaises(ValueError, compute.dispatch, 1, 1, 1, srv=[source])
+        self.assertRaises(ValueError, compute.dispatch, 1, 1, 1, wait=False)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "dynamic constants are supported only on Vulkan",
+    )
+    def test_constants(self):
+        shader = hlsl.compile(
+            """
+        struct Constants
+        {
+            uint values[1024];
+        };
+        ConstantBuffer<Constants> constants : register(b0);
+        RWBuffer<uint> target : register(u0);
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            target[tid.x] = constants.values[tid.x * 4];
+        }
+        """
+        )
+
+        target = Buffer(4 * 4, format=R32_UINT)
+        b_readback = Buffer(target.size, HEAP_READBACK)
+
+        compute = Compute(shader, uav=[target], constants_size=4096 * 4)
+        compute.dispatch(4, 1, 1, constants=struct.pack("<4096I", *range(0, 4096)))
+        target.copy_to(b_readback)
+        self.assertEqual(struct.unpack("<4I", b_readback.readback()), (0, 16, 32, 48))
+
+        for i in range(0, 512):
+            compute.dispatch(
+                1, 1, 1, constants=struct.pack("<4096I", *([i + 1] * 4096))
+            )
+        compute.dispatch(4, 1, 1)
+        target.copy_to(b_readback)
+        self.assertEqual(struct.unpack("<4I", b_readback.readback()), (512,) * 4)
+
+        self.assertRaises(
+            ValueError, compute.dispatch, 1, 1, 1, constants=b"\0" * (4096 * 4 + 1)
+        )
+
+        no_constants = Compute(
+            hlsl.compile(
+                """
+        RWBuffer<uint> target : register(u0);
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            target[tid.x] = 1;
+        }
+        """
+            ),
+            uav=[target],
+        )
+        self.assertRaises(ValueError, no_constants.dispatch, 1, 1, 1, constants=b"")
+        self.assertRaises(
+            ValueError, no_constants.dispatch, 1, 1, 1, constants=b"\0" * 4
+        )
+
     @unittest.skipIf(
         platform.system() == "Darwin", "Tests meaningless on Apple platform"
     )
@@ -376,6 +818,69 @@ class ComputeTests(unittest.TestCase):
             struct.unpack("<64I", b_readback.readback(4 * 64)), tuple(range(0, 64))
         )
 
+    @unittest.skipIf(
+        platform.system() == "Darwin", "Tests meaningless on Apple platform"
+    )
+    def test_bindless_legacy_many(self):
+        shader = hlsl.compile(
+            """
+        Buffer<uint> buffers[];
+        RWBuffer<uint> targets[];
+
+        [numthreads(1, 1, 1)]
+        void main(uint3 tid : SV_DispatchThreadID)
+        {
+            Buffer<uint> buffer0 = buffers[tid.x];
+            targets[0][tid.x] = buffer0[0];
+        }
+        """
+        )
+
+        compute = Compute(shader, bindless=True)
+
+        b_upload = Buffer(4, HEAP_UPLOAD)
+        b_output = Buffer(4 * 64, format=R32_UINT)
+        b_readback = Buffer(b_output.size, HEAP_READBACK)
+
+        compute.bind_uav_many(0, [b_output])
+
+        buffers = []
+        for i in range(0, 64):
+            b = Buffer(4, format=R32_UINT)
+            b_upload.upload(struct.pack("<I", i))
+            b_upload.copy_to(b)
+            buffers.append(b)
+
+        compute.bind_srv_many(0, buffers[0:32])
+        compute.bind_srv_many(32, buffers[32:])
+
+        self.assertRaises(ValueError, compute.bind_srv_many, 60, buffers[0:8])
+
+        compute.dispatch(64, 1, 1)
+
+        if compushady.get_backend().name == "vulkan":
+            # the descriptors cannot reference a buffer without the matching usage
+            read_only = Buffer(
+                4,
+                format=R32_UINT,
+                usage=compushady.USAGE_READ_ONLY | compushady.USAGE_TRANSFER,
+            )
+            storage_only = Buffer(
+                4,
+                format=R32_UINT,
+                usage=compushady.USAGE_STORAGE | compushady.USAGE_TRANSFER,
+            )
+            self.assertRaises(ValueError, compute.bind_uav, 1, read_only)
+            self.assertRaises(ValueError, compute.bind_uav_many, 1, [read_only])
+            self.assertRaises(ValueError, compute.bind_srv, 1, storage_only)
+            self.assertRaises(ValueError, compute.bind_srv_many, 1, [storage_only])
+
+        b_output.copy_to(b_readback)
+
+        self.assertEqual(
+            struct.unpack("<64I", b_readback.readback(4 * 64)), tuple(range(0, 64))
+        )
+
     @unittest.skipIf(
         platform.system() == "Darwin", "Tests meaningless on Apple platform"
     )
@@ -468,3 +973,101 @@ class ComputeTests(unittest.TestCase):
         self.assertEqual(
             struct.unpack("<64I", b_readback.readback(4 * 64)), tuple(range(0, 64))
         )
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "non waiting dispatches are supported only on Vulkan",
+    )
+    def test_release_while_pending(self):
+        shader = hlsl.compile(
+            """
+        Buffer<uint> input : register(t0);
+        RWBuffer<uint> output : register(u0);
+
+        struct PushConstants
+        {
+            uint iterations;
+        };
+
+        [[vk::push_constant]]
+        ConstantBuffer<PushConstants> push_constants;
+
+        [numthreads(64, 1, 1)]
+        void main(int3 tid : SV_DispatchThreadID)
+        {
+            uint value = input[tid.x];
+            for (uint i = 0; i < push_constants.iterations; i++)
+            {
+                value = value * 1664525 + 1013904223;
+            }
+            output[tid.x] = value;
+        }
+        """
+        )
+        iterations = 100000
+        b_upload = Buffer(4 * 64, HEAP_UPLOAD)
+        b_upload.upload(struct.pack("<64I", *range(0, 64)))
+        b_input = Buffer(4 * 64, format=R32_UINT)
+        b_upload.copy_to(b_input)
+        b_output = Buffer(4 * 64, format=R32_UINT)
+        compute = Compute(shader, srv=[b_input], uav=[b_output], push_size=4)
+
+        device = compushady.get_current_device()
+        compute.dispatch(1, 1, 1, struct.pack("<I", iterations), wait=False)
+        serial = device.submitted_serial
+        self.assertLess(device.completed_serial, serial)
+        # the input (and the pipeline) are released while the dispatch may be still running
+        del compute
+        del b_input
+
+        # the completion is detected by the fence of the submission
+        deadline = time.monotonic() + 30
+        while device.completed_serial < serial and time.monotonic() < deadline:
+            device.collect()
+        self.assertGreaterEqual(device.completed_serial, serial)
+
+        b_readback = Buffer(4 * 64, HEAP_READBACK)
+        b_output.copy_to(b_readback)
+        expected = numpy.arange(0, 64, dtype=numpy.uint32)
+        with numpy.errstate(over="ignore"):
+            for _ in range(0, iterations):
+                expected = expected * numpy.uint32(1664525) + numpy.uint32(1013904223)
+        self.assertEqual(
+            struct.unpack("<64I", b_readback.readback(4 * 64)), tuple(expected.tolist())
+        )
+        for message in device.get_debug_messages():
+            self.assertNotIn("in use", message)
+
+    def test_stream_processor(self):
+        shader = hlsl.compile(
+            """
+        Buffer<uint> input : register(t0);
+        RWBuffer<uint> output : register(u0);
+        [numthreads(1, 1, 1)]
+        void main(int3 tid : SV_DispatchThreadID)
+        {
+            output[tid.x] = input[tid.x] * 2;
+        }
+        """
+        )
+        processor = StreamProcessor(
+            shader,
+            64,
+            64,
+            lambda size: (size // 4, 1, 1),
+            input_format=R32_UINT,
+            output_format=R32_UINT,
+        )
+        values = list(range(0, 100))
+        chunks = [
+            numpy.array(values[i : i + 16], dtype=numpy.uint32)
+            for i in range(0, len(values), 16)
+        ]
+        output = []
+        processor.run(chunks, output.append)
+        self.assertEqual(len(output), 7)
+        self.assertEqual(len(output[-1]), 16)
+        for slot in processor.slots:
+            self.assertIsNone(slot["serial"])
+        result = struct.unpack("<100I", b"".join(output))
+        self.assertEqual(result, tuple([value * 2 for value in values]))
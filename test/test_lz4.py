@@ -0,0 +1,74 @@
+import unittest
+from compushady import Buffer, HEAP_UPLOAD, HEAP_READBACK
+from compushady.formats import R32_UINT
+from compushady import lz4
+import compushady.config
+
+compushady.config.set_debug(True)
+
+
+class LZ4Tests(unittest.TestCase):
+
+    def setUp(self):
+        self.data = b"".join(
+            [b"compushady " * (i % 7) + bytes([i % 256]) for i in range(0, 2000)]
+        )
+
+    def test_compress(self):
+        payload, blocks = lz4.compress(self.data, 4096)
+        self.assertLess(len(payload), len(self.data))
+        self.assertEqual(len(blocks), (len(self.data) + 4095) // 4096)
+        self.assertEqual(lz4.decompress(payload, blocks), self.data)
+        self.assertRaises(ValueError, lz4.compress, self.data, 4097)
+
+    def test_decompress_unordered(self):
+        payload, blocks = lz4.compress(self.data, 4096)
+        self.assertEqual(lz4.decompress(payload, list(reversed(blocks))), self.data)
+        # empty blocks do not contribute to the output
+        empty = [(0, 0, len(self.data), 0)]
+        self.assertEqual(lz4.decompress(payload, empty + blocks), self.data)
+        self.assertEqual(lz4.decompress(b"", []), b"")
+
+    def test_gpu_decompress(self):
+        payload, blocks = lz4.compress(self.data, 4096)
+        destination = Buffer((len(self.data) + 3) & ~3, format=R32_UINT)
+        readback = Buffer(destination.size, HEAP_READBACK)
+        decompressor = lz4.Decompressor()
+        decompressor.decompress(payload, blocks, destination)
+        destination.copy_to(readback)
+        self.assertEqual(readback.readback(len(self.data)), self.data)
+
+    def test_gpu_decompress_from_buffer(self):
+        payload, blocks = lz4.compress(self.data[0:1000], 256)
+        staging = Buffer(len(payload), HEAP_UPLOAD)
+        staging.upload(payload)
+        destination = Buffer(1000, format=R32_UINT)
+        readback = Buffer(1000, HEAP_READBACK)
+        lz4.Decompressor().decompress(staging, blocks, destination)
+        destination.copy_to(readback)
+        self.assertEqual(readback.readback(), self.data[0:1000])
+
+    def _gpu_decompress(self, data, block_size):
+        payload, blocks = lz4.compress(data, block_size)
+        destination = Buffer((len(data) + 3) & ~3, format=R32_UINT)
+        readback = Buffer(destination.size, HEAP_READBACK)
+        lz4.Decompressor().decompress(payload, blocks, destination)
+        destination.copy_to(readback)
+        return payload, blocks, readback.readback(len(data))
+
+    def test_gpu_decompress_overlapping_matches(self):
+        # runs of a short pattern are encoded as matches whose offset (1, 3) is
+        # smaller than their length, so the kernel copies bytes it just wrote
+        data = b"x" + b"a" * 1000 + b"abc" * 500 + b"0123456789abcdef" * 40
+        payload, blocks, result = self._gpu_decompress(data, 4096)
+        self.assertLess(len(payload), len(data) // 10)
+        self.assertEqual(lz4.decompress(payload, blocks), data)
+        self.assertEqual(result, data)
+
+    def test_gpu_decompress_multiple_blocks(self):
+        # more blocks than the threads of a group, the last one is partial
+        data = self.data[0 : 100 * 256 + 123]
+        payload, blocks, result = self._gpu_decompress(data, 256)
+        self.assertEqual(len(blocks), 101)
+        self.assertEqual(blocks[-1][3], 123)
+        self.assertEqual(result, data)
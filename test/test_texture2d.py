@@ -5,7 +5,9 @@ from compushady.formats import (
     R8G8B8A8_UNORM,
     get_pixel_size,
     R16G16B16A16_FLOAT,
+    R32_UINT,
 )
+from compushady.shaders import hlsl
 import compushady.config
 
 compushady.config.set_debug(True)
@@ -84,6 +86,38 @@ class Texture2DTests(unittest.TestCase):
             b"\xff\xff\xff\xff\xaa\xaa\xaa\xaa\xbb\xbb\xbb\xbb\xcc\xcc\xcc\xcc",
         )
 
+    def test_copy_region(self):
+        t0 = Texture2D(8, 8, R8G8B8A8_UINT)
+        b0 = Buffer(t0.size, HEAP_UPLOAD)
+        b0.upload(b"\0" * t0.size)
+        b0.copy_to(t0)
+        tile = Buffer(512, HEAP_UPLOAD)
+        tile.upload(b"\1\1\1\1" * 2)
+        tile.upload(b"\2\2\2\2" * 2, offset=256)
+        tile.copy_to(t0, dst_x=4, dst_y=2, width=2, height=2, buffer_row_pitch=256)
+        b1 = Buffer(256, HEAP_READBACK)
+        t0.copy_to(b1, src_x=3, src_y=3, width=4, height=1)
+        self.assertEqual(b1.readback(16), b"\0" * 4 + b"\2" * 8 + b"\0" * 4)
+        b2 = Buffer(t0.size, HEAP_READBACK)
+        t0.copy_to(b2)
+        self.assertEqual(
+            b2.readback(t0.width * 4, t0.row_pitch * 2),
+            b"\0" * 16 + b"\1" * 8 + b"\0" * 8,
+        )
+
+    def test_copy_region_invalid(self):
+        t0 = Texture2D(8, 8, R8G8B8A8_UINT)
+        b0 = Buffer(t0.size, HEAP_UPLOAD)
+        self.assertRaises(ValueError, b0.copy_to, t0, dst_x=6, width=4)
+        self.assertRaises(ValueError, b0.copy_to, t0, dst_x=8)
+        self.assertRaises(
+            ValueError, b0.copy_to, t0, buffer_row_pitch=t0.size, height=2
+        )
+        if compushady.get_backend().name == "d3d12":
+            # placed footprints must be 512 bytes aligned
+            self.assertRaises(ValueError, b0.copy_to, t0, src_offset=256, height=1)
+            self.assertRaises(ValueError, t0.copy_to, b0, dst_offset=4, height=1)
+
     @unittest.skipIf(
         platform.system() == "Darwin", "Tests meaningless on Apple platform"
     )
@@ -138,3 +172,210 @@ class Texture2DTests(unittest.TestCase):
         )
         staging_texture.copy_to(b_readback)
         self.assertEqual(b_readback.readback(4), b"\xff\xee\xdd\xaa")
+
+    @unittest.skipIf(
+        platform.system() == "Darwin", "Tests meaningless on Apple platform"
+    )
+    def test_sparse_bind_tiles(self):
+        heap = Heap(HEAP_DEFAULT, 1024 * 1024)
+        t0 = Texture2D(1024, 1024, format=R8G8B8A8_UNORM, sparse=True)
+
+        staging_texture = Texture2D(
+            t0.tile_width, t0.tile_height, format=R8G8B8A8_UNORM
+        )
+
+        b_upload = Buffer(staging_texture.size, HEAP_UPLOAD)
+        b_readback = Buffer(staging_texture.size, HEAP_READBACK)
+
+        b_upload.upload(b"\xff\xee\xdd\xaa")
+        b_upload.copy_to(staging_texture)
+
+        t0.bind_tiles([(0, 0, 0, heap), (1, 0, 0, heap, 0), (0, 1, 0, heap, 0, 0)])
+        t0.bind_tiles([(1, 0, 0, None)])
+
+        staging_texture.copy_to(
+            t0, dst_x=0, dst_y=t0.tile_height, width=t0.tile_width, height=t0.tile_height
+        )
+        t0.copy_to(
+            staging_texture,
+            src_x=0,
+            src_y=0,
+            width=t0.tile_width,
+            height=t0.tile_height,
+        )
+        staging_texture.copy_to(b_readback)
+        self.assertEqual(b_readback.readback(4), b"\xff\xee\xdd\xaa")
+
+        self.assertRaises(ValueError, t0.bind_tiles, [(t0.tiles_x, 0, 0, heap)])
+
+    @unittest.skipIf(
+        platform.system() == "Darwin", "Tests meaningless on Apple platform"
+    )
+    def test_sparse_bind_tiles_multiple_heaps(self):
+        t0 = Texture2D(1024, 1024, format=R8G8B8A8_UNORM, sparse=True)
+        heap0 = Heap(HEAP_DEFAULT, 1024 * 1024)
+        heap1 = Heap(HEAP_DEFAULT, 1024 * 1024)
+        t0.bind_tiles([(0, 0, 0, heap0), (1, 0, 0, heap1)])
+        # the texture keeps both heaps alive
+        del heap0
+        del heap1
+
+        staging_texture = Texture2D(
+            t0.tile_width, t0.tile_height, format=R8G8B8A8_UNORM
+        )
+        b_upload = Buffer(staging_texture.size, HEAP_UPLOAD)
+        b_readback = Buffer(staging_texture.size, HEAP_READBACK)
+        for tile, value in ((0, b"\x01\x02\x03\x04"), (1, b"\x05\x06\x07\x08")):
+            b_upload.upload(value)
+            b_upload.copy_to(staging_texture)
+            staging_texture.copy_to(
+                t0, dst_x=t0.tile_width * tile, width=t0.tile_width, height=t0.tile_height
+            )
+        for tile, value in ((0, b"\x01\x02\x03\x04"), (1, b"\x05\x06\x07\x08")):
+            t0.copy_to(
+                staging_texture,
+                src_x=t0.tile_width * tile,
+                width=t0.tile_width,
+                height=t0.tile_height,
+            )
+            staging_texture.copy_to(b_readback)
+            self.assertEqual(b_readback.readback(4), value)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan", "mips are supported only on Vulkan"
+    )
+    def test_mips(self):
+        t0 = Texture2D(8, 4, R8G8B8A8_UNORM, mips=4)
+        self.assertEqual(t0.mips, 4)
+        mip2 = t0.mip(2)
+        self.assertEqual((mip2.width, mip2.height), (2, 1))
+        self.assertEqual(mip2.size, 8)
+        mip3 = t0.mip(3)
+        self.assertEqual((mip3.width, mip3.height), (1, 1))
+        self.assertEqual(t0.mip_level, 0)
+        self.assertEqual(mip2.mip_level, 2)
+        self.assertEqual(mip3.mip_level, 3)
+
+        b_upload = Buffer(t0.size, HEAP_UPLOAD)
+        b_upload.upload(b"\x80\x40\x20\xff" * (t0.width * t0.height))
+        b_upload.copy_to(t0)
+        t0.generate_mips()
+
+        b_readback = Buffer(mip3.size, HEAP_READBACK)
+        mip3.copy_to(b_readback)
+        self.assertEqual(b_readback.readback(4), b"\x80\x40\x20\xff")
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan", "mips are supported only on Vulkan"
+    )
+    def test_mips_invalid(self):
+        self.assertRaises(ValueError, Texture2D, 8, 4, R8G8B8A8_UNORM, mips=5)
+        t0 = Texture2D(8, 4, R8G8B8A8_UNORM, mips=2)
+        self.assertRaises(ValueError, t0.mip, 2)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "slice views are supported only on Vulkan",
+    )
+    def test_slice_view(self):
+        t0 = Texture2D(2, 2, R8G8B8A8_UINT, slices=3)
+        v1 = t0.view(1)
+        self.assertEqual(v1.slices, 2)
+        self.assertEqual(v1.size, t0.size)
+        v2 = t0.view(2, 1)
+        self.assertEqual(v2.slices, 1)
+
+        b_upload = Buffer(t0.size, HEAP_UPLOAD)
+        b_upload.upload(b"\xDE\xAD\xBE\xEF" * 4)
+        b_upload.copy_to(v2)
+
+        b_readback = Buffer(t0.size, HEAP_READBACK)
+        t0.copy_to(b_readback, src_slice=2)
+        self.assertEqual(b_readback.readback(4), b"\xDE\xAD\xBE\xEF")
+        v1.copy_to(b_readback, src_slice=1)
+        self.assertEqual(b_readback.readback(4), b"\xDE\xAD\xBE\xEF")
+
+        self.assertRaises(ValueError, t0.view, 3)
+        self.assertRaises(ValueError, t0.view, 1, 3)
+        self.assertRaises(ValueError, v1.view, 0)
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "slice views are supported only on Vulkan",
+    )
+    def test_slice_view_dispatch(self):
+        t0 = Texture2D(2, 2, R32_UINT, slices=4)
+        b_upload = Buffer(t0.size, HEAP_UPLOAD)
+        b_upload.upload(b"\0" * t0.size)
+        for slice in range(0, 4):
+            b_upload.copy_to(t0, dst_slice=slice)
+
+        shader = hlsl.compile(
+            """
+RWTexture2DArray<uint> target : register(u0);
+[numthreads(1, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID)
+{
+    target[tid] = 0xCAFEBABE;
+}
+"""
+        )
+        # slice 0 of the view is slice 1 of the texture
+        compute = compushady.Compute(shader, uav=[t0.view(1, 2)])
+        compute.dispatch(2, 2, 2)
+
+        b_readback = Buffer(t0.size, HEAP_READBACK)
+        for slice, expected in enumerate((0, 0xCAFEBABE, 0xCAFEBABE, 0)):
+            t0.copy_to(b_readback, src_slice=slice)
+            self.assertEqual(
+                struct.unpack("II", b_readback.readback(8)), (expected, expected)
+            )
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "usage flags are supported only on Vulkan",
+    )
+    def test_read_only_usage(self):
+        t0 = Texture2D(
+            2,
+            2,
+            R8G8B8A8_UINT,
+            usage=compushady.USAGE_READ_ONLY | compushady.USAGE_TRANSFER,
+        )
+        self.assertEqual(t0.usage, compushady.USAGE_READ_ONLY | compushady.USAGE_TRANSFER)
+        b0 = Buffer(t0.size, HEAP_UPLOAD)
+        b0.upload(b"\xDE\xAD\xBE\xEF" * 4)
+        b0.copy_to(t0)
+
+        b1 = Buffer(4, format=R32_UINT)
+        shader = hlsl.compile(
+            """
+Texture2D<uint4> source : register(t0);
+RWBuffer<uint> target : register(u0);
+[numthreads(1, 1, 1)]
+void main()
+{
+    target[0] = source[uint2(1, 1)].b;
+}
+"""
+        )
+        compute = compushady.Compute(shader, srv=[t0], uav=[b1])
+        compute.dispatch(1, 1, 1)
+        b2 = Buffer(4, HEAP_READBACK)
+        b1.copy_to(b2)
+        self.assertEqual(struct.unpack("I", b2.readback(4))[0], 0xBE)
+
+        self.assertRaises(ValueError, compushady.Compute, shader, uav=[t0, b1])
+        t1 = Texture2D(2, 2, R8G8B8A8_UINT, usage=compushady.USAGE_READ_ONLY)
+        self.assertRaises(ValueError, b0.copy_to, t1)
+
+    def test_bulk_create(self):
+        textures = [Texture2D(2, 2, R8G8B8A8_UINT) for _ in range(0, 64)]
+        # textures released before the next submission
+        del textures[0:32]
+        b0 = Buffer(textures[-1].size, HEAP_UPLOAD)
+        b0.upload(b"\xDE\xAD\xBE\xEF" * 4)
+        b0.copy_to(textures[-1])
+        b1 = Buffer(textures[-1].size, HEAP_READBACK)
+        textures[-1].copy_to(b1)
+        self.assertEqual(b1.readback(4), b"\xDE\xAD\xBE\xEF")
@@ -1,6 +1,13 @@
 import unittest
 from compushady import Texture3D, Texture2D, Buffer, HEAP_UPLOAD, HEAP_READBACK
-from compushady.formats import R8G8B8A8_UINT, get_pixel_size, R16G16B16A16_FLOAT
+from compushady.formats import (
+    R8G8B8A8_UINT,
+    get_pixel_size,
+    R16G16B16A16_FLOAT,
+    R32_UINT,
+)
+from compushady.shaders import hlsl
+import compushady
 import compushady.config
 import struct
 
@@ -64,3 +71,62 @@ class Texture3DTests(unittest.TestCase):
         t1.copy_to(b2)
         self.assertEqual(b2.readback(1024), bytes(1024))
         self.assertNotEqual(b2.readback(), bytes(b2.size))
+
+    @unittest.skipIf(
+        compushady.get_backend().name != "vulkan",
+        "depth views are supported only on Vulkan",
+    )
+    def test_depth_view(self):
+        t0 = Texture3D(2, 2, 4, R32_UINT)
+        if not compushady.get_current_device().supports_sliced_view_of_3d:
+            self.assertRaises(ValueError, t0.view, 1, 2)
+            self.skipTest("VK_EXT_image_sliced_view_of_3d is not supported")
+
+        b_upload = Buffer(t0.size, HEAP_UPLOAD)
+        b_upload.upload(b"\0" * t0.size)
+        b_upload.copy_to(t0)
+
+        v0 = t0.view(1, 2)
+        self.assertEqual(v0.depth, 2)
+        self.assertRaises(ValueError, t0.view, 3, 2)
+
+        shader = hlsl.compile(
+            """
+RWTexture3D<uint> target : register(u0);
+[numthreads(1, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID)
+{
+    target[tid] = 0xCAFEBABE;
+}
+"""
+        )
+        # z 0 of the view is z 1 of the texture
+        compute = compushady.Compute(shader, uav=[v0])
+        compute.dispatch(2, 2, 2)
+
+        b_readback = Buffer(t0.size, HEAP_READBACK)
+        t0.copy_to(b_readback)
+        for z, expected in enumerate((0, 0xCAFEBABE, 0xCAFEBABE, 0)):
+            self.assertEqual(
+                struct.unpack(
+                    "II", b_readback.readback(8, offset=t0.row_pitch * t0.height * z)
+                ),
+                (expected, expected),
+            )
+
+        # a depth view cannot be sampled (it would expose the whole volume)
+        sampling_shader = hlsl.compile(
+            """
+Texture3D<uint> source : register(t0);
+RWBuffer<uint> target : register(u0);
+[numthreads(1, 1, 1)]
+void main()
+{
+    target[0] = source[uint3(0, 0, 0)];
+}
+"""
+        )
+        b0 = Buffer(4, format=R32_UINT)
+        self.assertRaises(
+            ValueError, compushady.Compute, sampling_shader, srv=[v0], uav=[b0]
+        )